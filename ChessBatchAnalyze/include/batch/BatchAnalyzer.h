@@ -0,0 +1,113 @@
+/**
+ * @file BatchAnalyzer.h
+ * @brief Parallel analysis of every position in a PGN or EPD file.
+ */
+#pragma once
+
+#include<atomic>
+#include<iosfwd>
+#include"framework/Pgn.h"
+#include"engine/Search.h"
+
+namespace chess
+{
+    /**
+     * @brief What to analyse and how hard.
+     */
+    struct BatchOptions
+    {
+        std::string mInputPath;     ///< PGN file, or EPD if it ends in ".epd"
+        SearchLimits mLimits;       ///< Fixed depth and/or node budget per position
+        int mThreads = 0;           ///< Worker threads, 0 for one per hardware thread
+        size_t mHashMB = TranspositionTable::DEFAULT_SIZE_MB; ///< Transposition table size of each worker
+    };
+
+    /**
+     * @brief Totals of a finished run.
+     */
+    struct BatchStats
+    {
+        uint64_t mGames = 0;        ///< PGN games analysed
+        uint64_t mTruncatedGames = 0; ///< Games whose movetext stopped at an unreadable move
+        uint64_t mEpdLines = 0;     ///< EPD lines analysed
+        uint64_t mPositions = 0;    ///< Positions searched
+        uint64_t mNodes = 0;        ///< Nodes searched over all positions
+        double mSeconds = 0.0;      ///< Wall time of the run
+    };
+
+    /**
+     * @brief Analyses a game collection on a `WorkStealingPool`.
+     *
+     * The input is memory mapped and read by the calling thread, one game
+     * (or EPD line) per task. Each worker owns a `Search` and its own
+     * transposition table, so positions are searched without sharing any
+     * state, and nothing touches `ChessState`. The table is cleared for
+     * every game, so the output does not depend on the thread count.
+     *
+     * PGN games are written back with a "[%eval]" comment after every move
+     * and "?!", "?" or "??" plus the best move where the played move lost
+     * enough against it. A game the reader had to truncate is reported on
+     * stderr and written with a "Truncated" tag, so the shortened movetext
+     * is not mistaken for the whole game. EPD lines get "bm", "ce" (or "dm"), "acd" and
+     * "acn" operations, replacing any the line already had. Output keeps the input order; only a bounded
+     * window of games is in flight, so files of any size are processed in
+     * constant memory.
+     */
+    class BatchAnalyzer
+    {
+        public:
+            explicit BatchAnalyzer(const BatchOptions& options);
+
+            /**
+             * @brief Analyse the whole input.
+             * @param output Receives the annotated games or EPD lines
+             * @return False if the input could not be opened
+             */
+            bool Run(std::ostream& output);
+
+            /** @brief Totals of the last `Run`. */
+            const BatchStats& GetStats() const { return mStats; }
+
+        private:
+            /**
+             * @brief Search state owned by one worker thread.
+             */
+            struct WorkerState
+            {
+                explicit WorkerState(size_t hashMB)
+                    :mTable{hashMB},
+                    mSearch{mTable}
+                {
+                }
+
+                TranspositionTable mTable;  ///< Private to the worker
+                Search mSearch;             ///< Searches `mTable`
+            };
+
+            /** @brief Search every position of a game, annotate its moves and write it in PGN. */
+            void AnalyseGame(PgnGame& game, WorkerState& worker, std::string& output);
+
+            /** @brief Search the position of one EPD line and append the result operations. */
+            void AnalyseEpd(std::string_view line, WorkerState& worker, std::string& output);
+
+            /**
+             * @brief Search one position with the configured limits.
+             * @return The search result; its score is a mate or draw score when there is no legal move
+             */
+            SearchResult SearchPosition(const Position& position, const List<uint64_t>& history, WorkerState& worker);
+
+            /** @brief Mistake thresholds in centipawns lost against the best move. */
+            static constexpr int INACCURACY_LOSS = 50;
+            static constexpr int MISTAKE_LOSS = 100;
+            static constexpr int BLUNDER_LOSS = 300;
+
+            /** @brief Scores are clamped to this before measuring a loss, so "mate in 5 instead of 3" is no blunder. */
+            static constexpr int MAX_LOSS_SCORE = 1000;
+
+            BatchOptions mOptions;                  ///< Input and limits
+            BatchStats mStats;                      ///< Totals of the last run
+            List<unique<WorkerState>> mWorkers;     ///< Indexed by pool worker
+            std::atomic<uint64_t> mPositions;       ///< Positions searched by all workers
+            std::atomic<uint64_t> mNodes;           ///< Nodes searched by all workers
+    };
+}
@@ -0,0 +1,350 @@
+/**
+ * @file BatchAnalyzer.cpp
+ * @brief Input splitting, per-position searches and annotation.
+ */
+#include"batch/BatchAnalyzer.h"
+#include"engine/WorkStealingPool.h"
+#include"framework/MappedFile.h"
+#include"framework/San.h"
+#include<algorithm>
+#include<chrono>
+#include<cstdio>
+#include<deque>
+#include<sstream>
+
+namespace chess
+{
+    namespace
+    {
+        /** @brief Tasks in flight per worker before the reader waits; bounds memory and output reordering. */
+        constexpr size_t JOBS_PER_THREAD = 4;
+
+        /**
+         * @brief One game or EPD line, and its output once a worker has finished it.
+         */
+        struct Job
+        {
+            PgnGame mGame;                  ///< Game to analyse (PGN input)
+            std::string_view mLine;         ///< Line to analyse (EPD input)
+            std::string mOutput;            ///< Annotated text, complete once `mDone` is set
+            std::atomic<bool> mDone{false}; ///< Set by the worker, read by the reader thread
+        };
+
+        /** @brief "[%eval 0.35]" or "[%eval #-3]" from white's point of view. */
+        std::string FormatEval(int whiteScore)
+        {
+            char buffer[32];
+            if(whiteScore >= MATE_BOUND)
+                std::snprintf(buffer, sizeof(buffer), "[%%eval #%d]", (MATE_SCORE - whiteScore + 1) / 2);
+            else if(whiteScore <= -MATE_BOUND)
+                std::snprintf(buffer, sizeof(buffer), "[%%eval #-%d]", (MATE_SCORE + whiteScore + 1) / 2);
+            else
+                std::snprintf(buffer, sizeof(buffer), "[%%eval %.2f]", whiteScore / 100.0);
+            return buffer;
+        }
+
+        /** @brief EPD opcodes written by `AnalyseEpd`; earlier values of them are dropped. */
+        constexpr std::string_view RESULT_OPCODES[] = {"bm", "ce", "dm", "acd", "acn"};
+
+        /**
+         * @brief Copy the EPD operations in `operations` to `output`, each as " opcode operands;".
+         *
+         * Operations whose opcode `AnalyseEpd` writes are left out. A ';'
+         * inside a quoted operand does not end the operation.
+         */
+        void AppendKeptOperations(std::string_view operations, std::string& output)
+        {
+            size_t offset = 0;
+            while(offset < operations.size())
+            {
+                size_t end = offset;
+                bool quoted = false;
+                while(end < operations.size() && (quoted || operations[end] != ';'))
+                {
+                    if(operations[end] == '"') quoted = !quoted;
+                    end++;
+                }
+                std::string_view operation = operations.substr(offset, end - offset);
+                offset = end + 1;
+
+                size_t first = operation.find_first_not_of(' ');
+                if(first == std::string_view::npos)
+                    continue;
+                operation = operation.substr(first, operation.find_last_not_of(' ') + 1 - first);
+                std::string_view opcode = operation.substr(0, operation.find(' '));
+                if(std::find(std::begin(RESULT_OPCODES), std::end(RESULT_OPCODES), opcode) != std::end(RESULT_OPCODES))
+                    continue;
+
+                output += ' ';
+                output += operation;
+                output += ';';
+            }
+        }
+
+        /** @brief True if the game has a FEN tag the reader could not set up, leaving no start position. */
+        bool HasUnusableFen(const PgnGame& game)
+        {
+            std::string_view fen = game.GetTag("FEN");
+            Position position;
+            return !fen.empty() && !position.SetFromFen(fen);
+        }
+
+        /**
+         * @brief Write a game in PGN, with a "Truncated" tag saying where a cut-off game stops.
+         * @param truncatedAt Value of the tag, only used if the game is truncated
+         */
+        void WriteGame(PgnGame& game, const std::string& truncatedAt, std::string& output)
+        {
+            if(game.mTruncated)
+                game.mTags.push_back(PgnTag{"Truncated", truncatedAt});
+
+            std::ostringstream stream;
+            PgnWriter::Write(stream, game);
+            output = stream.str();
+            if(game.mTruncated)
+                game.mTags.pop_back();
+        }
+
+        bool EndsWith(std::string_view text, std::string_view suffix)
+        {
+            return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+        }
+    }
+
+    BatchAnalyzer::BatchAnalyzer(const BatchOptions &options)
+        :mOptions{options},
+        mStats{},
+        mWorkers{},
+        mPositions{0},
+        mNodes{0}
+    {
+    }
+
+    /**
+     * @brief Read jobs on this thread, analyse them on the pool and write them back in order.
+     */
+    bool BatchAnalyzer::Run(std::ostream &output)
+    {
+        MappedFile file;
+        if(!file.Open(mOptions.mInputPath))
+            return false;
+
+        auto start = std::chrono::steady_clock::now();
+        mStats = BatchStats{};
+        mPositions.store(0, std::memory_order_relaxed);
+        mNodes.store(0, std::memory_order_relaxed);
+
+        WorkStealingPool pool{mOptions.mThreads};
+        mWorkers.clear();
+        for(int i = 0; i < pool.GetThreadCount(); i++)
+            mWorkers.push_back(std::make_unique<WorkerState>(mOptions.mHashMB));
+
+        // A deque never moves its elements, so workers can hold on to their job
+        std::deque<Job> jobs;
+        size_t maxInFlight = JOBS_PER_THREAD * static_cast<size_t>(pool.GetThreadCount());
+        bool epd = EndsWith(mOptions.mInputPath, ".epd");
+
+        auto flush = [&jobs, &output]()
+        {
+            while(!jobs.empty() && jobs.front().mDone.load(std::memory_order_acquire))
+            {
+                output << jobs.front().mOutput;
+                jobs.pop_front();
+            }
+        };
+        auto submit = [&](Job& job)
+        {
+            pool.Submit([this, &job, epd](int worker)
+            {
+                if(epd)
+                    AnalyseEpd(job.mLine, *mWorkers[worker], job.mOutput);
+                else
+                    AnalyseGame(job.mGame, *mWorkers[worker], job.mOutput);
+                job.mDone.store(true, std::memory_order_release);
+            });
+
+            if(jobs.size() < maxInFlight)
+                return;
+            pool.Wait(static_cast<size_t>(pool.GetThreadCount()));
+            flush();
+            // A slow game at the front holds back the rest; do not let them pile up
+            if(jobs.size() >= 2 * maxInFlight)
+            {
+                pool.Wait();
+                flush();
+            }
+        };
+
+        std::string_view text = file.GetData();
+        if(epd)
+        {
+            size_t offset = 0;
+            while(offset < text.size())
+            {
+                size_t end = std::min(text.find('\n', offset), text.size());
+                std::string_view line = text.substr(offset, end - offset);
+                offset = end + 1;
+                while(!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+                    line.remove_suffix(1);
+                if(line.empty() || line.front() == '#')
+                    continue;
+
+                Job& job = jobs.emplace_back();
+                job.mLine = line;
+                mStats.mEpdLines++;
+                submit(job);
+            }
+        }
+        else
+        {
+            PgnReader reader{text};
+            while(true)
+            {
+                Job& job = jobs.emplace_back();
+                if(!reader.ReadGame(job.mGame))
+                {
+                    jobs.pop_back();
+                    break;
+                }
+                mStats.mGames++;
+                if(job.mGame.mTruncated)
+                {
+                    mStats.mTruncatedGames++;
+                    std::string_view white = job.mGame.GetTag("White"), black = job.mGame.GetTag("Black");
+                    if(HasUnusableFen(job.mGame))
+                        std::fprintf(stderr, "Game %llu (%.*s - %.*s) skipped: its FEN tag is not a valid position\n",
+                                     static_cast<unsigned long long>(mStats.mGames), static_cast<int>(white.size()), white.data(),
+                                     static_cast<int>(black.size()), black.data());
+                    else
+                        std::fprintf(stderr, "Game %llu (%.*s - %.*s) truncated after %zu plies: a move could not be read\n",
+                                     static_cast<unsigned long long>(mStats.mGames), static_cast<int>(white.size()), white.data(),
+                                     static_cast<int>(black.size()), black.data(), job.mGame.mMoves.size());
+                }
+                submit(job);
+            }
+        }
+
+        pool.Wait();
+        flush();
+
+        mStats.mPositions = mPositions.load(std::memory_order_relaxed);
+        mStats.mNodes = mNodes.load(std::memory_order_relaxed);
+        mStats.mSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    /**
+     * @brief Search the position before every move and the final one, then
+     * compare each played move against the best move of its position.
+     *
+     * The loss of a move is the best score minus the score after the move,
+     * both for the player who made it. A game whose FEN tag could not be set
+     * up has no start position, so it is written back unsearched.
+     */
+    void BatchAnalyzer::AnalyseGame(PgnGame &game, WorkerState &worker, std::string &output)
+    {
+        if(game.mTruncated && HasUnusableFen(game))
+        {
+            WriteGame(game, "invalid FEN", output);
+            return;
+        }
+
+        // An empty table makes the result independent of what this worker analysed before
+        worker.mTable.Clear();
+
+        size_t moveCount = game.mMoves.size();
+        List<int> scores(moveCount + 1);
+        List<Move> bestMoves(moveCount + 1);
+        List<uint64_t> history;
+        history.reserve(moveCount);
+
+        Position position = game.mStartPosition;
+        List<Position> positions;
+        positions.reserve(moveCount);
+        for(size_t i = 0; i <= moveCount; i++)
+        {
+            SearchResult result = SearchPosition(position, history, worker);
+            scores[i] = result.mScore;
+            bestMoves[i] = result.mBestMove;
+            if(i == moveCount)
+                break;
+
+            positions.push_back(position);
+            history.push_back(position.GetHash());
+            UndoRecord undo;
+            position.MakeMove(game.mMoves[i], undo);
+        }
+
+        game.mAnnotations.resize(moveCount);
+        for(size_t i = 0; i < moveCount; i++)
+        {
+            bool white = positions[i].IsWhiteToMove();
+            int scoreAfter = -scores[i + 1];
+            PgnAnnotation& annotation = game.mAnnotations[i];
+            annotation.mComment = FormatEval(white ? scoreAfter : -scoreAfter);
+
+            if(game.mMoves[i] == bestMoves[i])
+                continue;
+            int loss = std::clamp(scores[i], -MAX_LOSS_SCORE, MAX_LOSS_SCORE) - std::clamp(scoreAfter, -MAX_LOSS_SCORE, MAX_LOSS_SCORE);
+            if(loss >= BLUNDER_LOSS) annotation.mNag = 4;
+            else if(loss >= MISTAKE_LOSS) annotation.mNag = 2;
+            else if(loss >= INACCURACY_LOSS) annotation.mNag = 6;
+            else continue;
+            annotation.mComment += " best " + San::ToString(positions[i], bestMoves[i]);
+        }
+
+        WriteGame(game, "after ply " + std::to_string(moveCount), output);
+    }
+
+    /**
+     * @brief The first four fields are the position; the operations after
+     * them are kept, except the ones this analysis writes itself.
+     */
+    void BatchAnalyzer::AnalyseEpd(std::string_view line, WorkerState &worker, std::string &output)
+    {
+        size_t fieldsEnd = 0;
+        for(int field = 0; field < 4 && fieldsEnd < line.size(); field++)
+        {
+            fieldsEnd = line.find_first_not_of(' ', fieldsEnd);
+            fieldsEnd = std::min(line.find(' ', fieldsEnd), line.size());
+        }
+
+        Position position;
+        if(!position.SetFromFen(line.substr(0, fieldsEnd)))
+        {
+            output.assign(line);
+            output += '\n';
+            return;
+        }
+
+        output.assign(line.substr(0, fieldsEnd));
+        AppendKeptOperations(line.substr(fieldsEnd), output);
+
+        worker.mTable.Clear();
+        SearchResult result = SearchPosition(position, {}, worker);
+        if(result.mBestMove.IsValid())
+            output += " bm " + San::ToString(position, result.mBestMove) + ";";
+        // A mated side has no moves left to count, so it gets no "dm"
+        if(result.mScore >= MATE_BOUND)
+            output += " dm " + std::to_string((MATE_SCORE - result.mScore + 1) / 2) + ";";
+        else if(result.mScore <= -MATE_BOUND && result.mScore > -MATE_SCORE)
+            output += " dm -" + std::to_string((MATE_SCORE + result.mScore) / 2) + ";";
+        else if(result.mScore > -MATE_BOUND)
+            output += " ce " + std::to_string(result.mScore) + ";";
+        output += " acd " + std::to_string(result.mDepth) + "; acn " + std::to_string(result.mNodes) + ";\n";
+    }
+
+    /**
+     * @brief Without a legal move the search reports nothing, so score mate or stalemate here.
+     */
+    SearchResult BatchAnalyzer::SearchPosition(const Position &position, const List<uint64_t> &history, WorkerState &worker)
+    {
+        SearchResult result = worker.mSearch.Run(position, mOptions.mLimits, history);
+        mPositions.fetch_add(1, std::memory_order_relaxed);
+        mNodes.fetch_add(result.mNodes, std::memory_order_relaxed);
+
+        if(!result.mBestMove.IsValid())
+            result.mScore = position.IsInCheck(position.IsWhiteToMove()) ? -MATE_SCORE : 0;
+        return result;
+    }
+}
@@ -65,12 +65,12 @@ namespace chess
       /**
        * @brief Enumerate pseudo-legal bishop moves from a coordinate.
        *
-       * Traverses diagonals in four directions until blocked, collecting empty
-       * squares and one capture square per ray.
+       * Looks the diagonals up in the magic attack tables, keeping empty
+       * squares and enemy-occupied squares.
        * @param pieceCoordinate Current bishop coordinate.
-       * @return List of reachable squares without considering king safety.
+       * @param moves Reachable squares are appended here, without considering king safety.
        */
-      virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)override;
+      virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)override;
     private:
       /** @brief Current on-screen location of the bishop sprite. */
       virtual sf::Vector2f GetPieceLocation()const override;
@@ -80,14 +80,8 @@ namespace chess
       /** @brief Center the sprite origin to simplify positioning/rotation. */
       virtual void CenterPivot() override;
 
-      /**
-       * @brief Whether a piece at `endCoordinate` belongs to the opponent.
-       */
-      bool isEnemy(ChessCoordinate& endCoordinate);
-      /**
-       * @brief Check if there are any pieces between start and end on a diagonal.
-       */
-      bool PiecesInBetweenPath(ChessCoordinate& startCoordinate, ChessCoordinate& endCoordinate);
+      /** @brief Squares reachable from `pieceCoordinate` via the magic attack tables, excluding own pieces. */
+      uint64_t GetTargets(const ChessCoordinate& pieceCoordinate);
 
       Stage* mOwningStage; ///< Owning stage used for rendering and scaling
       
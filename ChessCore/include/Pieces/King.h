@@ -47,9 +47,9 @@ namespace chess
       virtual void SetPieceRotation(float newRotation, bool whitePieces) override;
 
       /**
-       * @brief Gives List of all possible moves for the king.
+       * @brief Append all possible moves for the king.
        */
-      virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)override;
+      virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)override;
 
       /** @brief Whether the king is currently in check. */
       bool IsInCheck();
@@ -43,7 +43,7 @@ namespace chess
             virtual void SetPieceRotation(float newRotation, bool whitePieces) override;
 
             /** @brief legal knight moves from a square. */
-            virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)override;
+            virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)override;
         private:
             /** @brief Current on-screen location. */
             virtual sf::Vector2f GetPieceLocation()const override;
@@ -44,7 +44,7 @@ namespace chess
       virtual void SetPieceRotation(float newRotation, bool whitePieces) override;
 
       /** @brief legal pawn moves from a square. */
-      virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)override;
+      virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)override;
 
       /**
        * @brief Detect if any pawn reached last rank and must be promoted.
@@ -80,11 +80,5 @@ namespace chess
       sf::Sprite mBlackPawnSprite; ///< Sprite for black pawn
 
       bool mWhitePieces; ///< True if white, else black
-
-      /**
-       * @brief Tracks whether each pawn on its starting file has moved yet,
-       * enabling the double-step on its first move.
-       */
-      Dictionary<ChessCoordinate,bool,ChessCoordinateHashFunction> mFirstMove;
   };
 }
\ No newline at end of file
@@ -49,7 +49,7 @@ namespace chess
       /**
        * @brief legal queen moves from a square.
        */
-      virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)override;
+      virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)override;
     private:
       /** @brief Current on-screen location. */
       virtual sf::Vector2f GetPieceLocation()const override;
@@ -59,10 +59,8 @@ namespace chess
       /** @brief Center sprite origin for simpler transforms. */
       virtual void CenterPivot() override;
 
-      /** @brief Whether target square contains an enemy piece. */
-      bool isEnemy(ChessCoordinate& endCoordinate);
-      /** @brief Whether any pieces block the path to destination. */
-      bool PiecesInBetweenPath(ChessCoordinate& startCoordinate, ChessCoordinate& endCoordinate);
+      /** @brief Squares reachable from `pieceCoordinate` via the magic attack tables, excluding own pieces. */
+      uint64_t GetTargets(const ChessCoordinate& pieceCoordinate);
 
       Stage* mOwningStage; ///< Owning stage for rendering context
       
@@ -42,7 +42,7 @@ namespace chess
       virtual void SetPieceRotation(float newRotation, bool whitePieces) override;
 
       /** @brief legal rook moves from a square. */
-      virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)override;
+      virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)override;
 
     private:
       /** @brief Current on-screen location. */
@@ -53,19 +53,8 @@ namespace chess
       /** @brief Center sprite origin for simpler transforms. */
       virtual void CenterPivot() override;
 
-      /**
-       * @brief Whether target square contains an enemy piece.
-       * @param endCoordinate Target square.
-       * @return true if enemy piece present.
-       */
-      bool isEnemy(ChessCoordinate& endCoordinate);
-      /**
-       * @brief Whether any pieces block the path to destination.
-       * @param startCoordinate Start square.
-       * @param endCoordinate destination square.
-       * @return true if any pieces block the path.
-       */
-      bool PiecesInBetweenPath(ChessCoordinate& startCoordinate, ChessCoordinate& endCoordinate);
+      /** @brief Squares reachable from `pieceCoordinate` via the magic attack tables, excluding own pieces. */
+      uint64_t GetTargets(const ChessCoordinate& pieceCoordinate);
 
       Stage* mOwningStage; ///< Owning stage for rendering context
       
@@ -14,6 +14,21 @@
 
 namespace chess 
 {
+  /**
+   * @brief How often the application ticks and presents frames
+   * 
+   * Ticks run on a fixed step independent of rendering; frames are only
+   * presented when something was invalidated, and no faster than the
+   * frame rate limit (or the display's refresh with vertical sync).
+   */
+  struct FramePacing
+  {
+    float mTickRate = 120.f;      ///< Fixed simulation steps per second
+    float mFrameRateLimit = 60.f; ///< Most frames presented per second, 0 for no limit
+    int mMaxCatchUpTicks = 5;     ///< Ticks run back to back after a stall before the backlog is dropped
+    bool mVerticalSync = false;   ///< Present in step with the display instead of the frame rate limit
+  };
+
   /**
    * @brief Main application class that manages the game loop and window
    * 
@@ -55,6 +70,20 @@ namespace chess
      */
     virtual void Render();
 
+    /**
+     * @brief Sets the tick rate, frame rate limit, catch-up cap and vertical sync
+     * 
+     * @param framePacing The new pacing, used from the next loop iteration
+     */
+    void SetFramePacing(const FramePacing& framePacing);
+
+    /**
+     * @brief Gets the current frame pacing
+     * 
+     * @return const FramePacing& The tick and frame rates in use
+     */
+    const FramePacing& GetFramePacing() const { return mFramePacing; }
+
     /**
      * @brief Gets the SFML render window
      * 
@@ -96,6 +125,20 @@ namespace chess
      * @return true if the event was handled, false otherwise
      */
     bool DispathEvent(const std::optional<sf::Event>& event);
+
+    /**
+     * @brief Block until an event arrives or the timeout expires, then handle every pending event
+     * 
+     * @param timeout Longest time to wait for the first event
+     */
+    void WaitForEvents(sf::Time timeout);
+
+    /**
+     * @brief Handles one window event: closes, invalidates or dispatches it
+     * 
+     * @param event The SFML event to handle
+     */
+    void HandleWindowEvent(const std::optional<sf::Event>& event);
     
     /**
      * @brief Internal tick function that handles frame timing
@@ -109,10 +152,19 @@ namespace chess
      */
     void RenderInternal();
 
+    /**
+     * @brief Time left before the frame rate limit allows the next frame
+     * 
+     * @return sf::Time Zero if a frame may be presented now
+     */
+    sf::Time TimeUntilNextFrame() const;
+
     sf::RenderWindow mWindow;     ///< The main render window
 
-    float mTargetFrameRate;       ///< The target frames per second
-    sf::Clock mTickClock;         ///< Clock used for frame timing
+    FramePacing mFramePacing;     ///< Tick and frame rates
+    sf::Clock mTickClock;         ///< Clock used for tick timing
+    sf::Clock mFrameClock;        ///< Time since the last presented frame
+    sf::Time mIdleTickInterval;   ///< Longest sleep while the stage has nothing in flight
     
     shared<Stage> mCurrentStage;  ///< The currently active stage
   };
@@ -41,6 +41,24 @@ namespace chess
        * @note If the texture is already loaded, returns the cached version
        */
       shared<sf::Texture> LoadTexture(const std::string& texturePath);
+
+      /**
+       * @brief Load a texture sized for how large it is drawn
+       * 
+       * Paths of a size set (".../1024px/name_1024px.png") are swapped for
+       * the smallest variant on disk that is at least `targetSize` pixels
+       * (128px, 256px, 512px, ...). Whatever is loaded is then halved
+       * while it is still twice the target, so memory and decode time
+       * follow the on-screen size instead of the source resolution.
+       * 
+       * @param texturePath Path to the texture file relative to the root directory
+       * @param targetSize Largest on-screen side in pixels; 0 loads the file as is
+       * @param mipmapped Smooth the texture and generate mipmaps for further scaling down
+       * @return shared<sf::Texture> Shared pointer to the loaded texture, or nullptr if loading failed
+       * 
+       * @note Each path, size and mipmap combination is cached separately
+       */
+      shared<sf::Texture> LoadTexture(const std::string& texturePath, unsigned int targetSize, bool mipmapped = false);
       
       /**
        * @brief Load a font from file
@@ -76,6 +94,15 @@ namespace chess
        */
       template<typename T>
       shared<T> LoadAssets(const std::string& path, Dictionary<std::string, shared<T>> &container);
+
+      /**
+       * @brief Find the smallest size variant of a texture that still covers the target size
+       * 
+       * @param texturePath Path of a texture, possibly from a "<N>px" set
+       * @param targetSize Largest on-screen side in pixels
+       * @return std::string Path of the variant, or `texturePath` if there is no smaller one
+       */
+      std::string FindSizeVariant(const std::string& texturePath, unsigned int targetSize) const;
       
       static unique<AssetManager> mAssetManager;                       ///< Singleton instance
       Dictionary<std::string, shared<sf::Texture>> mLoadedTextures;    ///< Cache of loaded textures
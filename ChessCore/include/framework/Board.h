@@ -22,6 +22,13 @@ namespace chess
    * at `mBoardStart` with overall size `mBoardDimensions`. It computes square
    * offsets and sprite scales to fit the desired dimensions. Use
    * `GetSquareBound()` to query the approximate on-screen bounds of any tile.
+   *
+   * The 64 squares are baked once into a render texture and drawn as a
+   * single sprite. If the render texture cannot be created the squares are
+   * drawn one by one and the bake is tried again on the next draw; after a
+   * second failure the board keeps drawing the squares one by one. The
+   * pattern looks the same from either side, so flipping the board does
+   * not need a new bake.
    */
   class Board
   {
@@ -36,7 +43,7 @@ namespace chess
     Board(Stage* owningStage, const sf::Vector2f& boardStart = sf::Vector2f{0.f,0.f}, const sf::Vector2f& boardDimensions = sf::Vector2f{800.f,800.f});
     
     /**
-     * @brief Redraw the entire 8x8 board using current metrics (scale/offsets).
+     * @brief Draw the 8x8 board, baking it first if it has not been baked yet.
      */
     void RefreshBoard();
 
@@ -71,18 +78,21 @@ namespace chess
     
     private:
     /**
-     * @brief Draw a dark/black square at the given position.
+     * @brief Compute per-tile offsets and sprite scale from board dimensions.
      */
-    void RenderBlackSquare(const sf::Vector2f& position);
+    void CalculateSquareOffset();
+
     /**
-     * @brief Draw a light/white square at the given position.
+     * @brief Draw all 64 squares to a render target, the board's top-left at `origin`.
      */
-    void RenderWhiteSquare(const sf::Vector2f& position);
+    void DrawSquares(sf::RenderTarget& target, const sf::Vector2f& origin);
 
     /**
-     * @brief Compute per-tile offsets and sprite scale from board dimensions.
+     * @brief Render the squares into `mBakedBoard`.
+     *
+     * @return false if the render texture could not be created.
      */
-    void CalculateSquareOffset();
+    bool BakeBoard();
 
     Stage* mOwingStage;          ///< Back-reference to owning stage (for drawing)
     sf::Vector2f mBoardStart;    ///< Top-left corner of the board in pixels
@@ -97,5 +107,10 @@ namespace chess
     float mScaleY;               ///< Vertical scale for square sprites
     float mOffsetY;              ///< Per-tile vertical spacing
     float mOffsetX;              ///< Per-tile horizontal spacing
+
+    sf::RenderTexture mBakedBoard; ///< All squares, rendered once
+    sf::Sprite mBakedBoardSprite;  ///< Draws `mBakedBoard` at `mBoardStart`
+    bool mBakeDirty;               ///< Not baked yet, or the last bake failed
+    int mBakeFailures;             ///< Failed bakes so far; none are tried after the limit
   };
 }
@@ -8,6 +8,7 @@
 
 #include<SFML/Graphics.hpp>
 #include"framework/Core.h"
+#include"framework/Move.h"
 
 namespace chess
 {
@@ -59,9 +60,11 @@ namespace chess
             virtual void SetPieceRotation(float newRotation, bool whitePieces) = 0;
 
             /**
-             * @brief Enumerate all pseudo-legal moves for the piece from a square.
+             * @brief Append all pseudo-legal moves for the piece from a square.
+             * @param pieceCoordinate Square the piece stands on
+             * @param moves List the moves are appended to
              */
-            virtual List<ChessCoordinate> GetAllPossibleMoves(const ChessCoordinate pieceCoordinate) = 0;
+            virtual void GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves) = 0;
         private:
             /** @brief Get current piece location in window coordinates. */
             virtual sf::Vector2f GetPieceLocation()const = 0;
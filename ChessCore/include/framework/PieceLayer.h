@@ -0,0 +1,88 @@
+/**
+ * @file PieceLayer.h
+ * @brief Batched rendering of every piece on the board from one texture atlas
+ */
+
+#pragma once
+
+#include<functional>
+#include<SFML/Graphics.hpp>
+#include"framework/Core.h"
+
+namespace chess
+{
+  class Stage;
+
+  /**
+   * @brief Draws all pieces of the current position with one draw call.
+   *
+   * The twelve piece images are packed into a single atlas at construction,
+   * each cell already at its on-screen size. `Rebuild()` turns the piece
+   * bitboards into one `sf::VertexArray` of textured quads; it only has to
+   * run when the position, the board orientation or the hidden (dragged)
+   * square changes, which `IsCurrent()` tells. `Draw()` is then a single
+   * draw with a single texture bind.
+   */
+  class PieceLayer
+  {
+    public:
+    /**
+     * @brief Build the atlas.
+     *
+     * @param owningStage Stage whose piece size the atlas cells are made for.
+     */
+    PieceLayer(Stage* owningStage);
+
+    /**
+     * @brief Whether the atlas could be created; if not, pieces have to be drawn one by one.
+     */
+    inline bool IsValid()const { return mValid; }
+
+    /**
+     * @brief Whether the vertex array already shows this board.
+     *
+     * @param positionHash Zobrist key of the position.
+     * @param flipped Whether the board is seen from black's side.
+     * @param hiddenSquare Square left out (the dragged piece), or `NO_SQUARE`.
+     */
+    bool IsCurrent(uint64_t positionHash, bool flipped, int hiddenSquare)const;
+
+    /**
+     * @brief Rebuild the vertex array from the current `ChessState` bitboards.
+     *
+     * @param positionHash Zobrist key of the position.
+     * @param flipped Whether the board is seen from black's side.
+     * @param hiddenSquare Square to leave out, or `NO_SQUARE`.
+     * @param squareToPosition Window position of a square's top-left piece anchor.
+     */
+    void Rebuild(uint64_t positionHash, bool flipped, int hiddenSquare, const std::function<sf::Vector2f(int)>& squareToPosition);
+
+    /**
+     * @brief Draw every piece in one call.
+     */
+    void Draw(sf::RenderTarget& target)const;
+
+    private:
+    /**
+     * @brief Render the twelve piece textures into `mAtlas`.
+     *
+     * @return false if the render texture could not be created.
+     */
+    bool BuildAtlas(Stage& owningStage);
+
+    /**
+     * @brief Append the two triangles of one piece.
+     */
+    void AppendQuad(PieceType piece, const sf::Vector2f& position);
+
+    sf::RenderTexture mAtlas;     ///< All piece images, one cell each
+    sf::Vector2f mCellSize;       ///< Size of a cell in the atlas and of a piece on screen
+    sf::VertexArray mVertices;    ///< Six vertices per piece on the board
+    bool mValid;                  ///< The atlas was created
+
+    bool mBuilt;                  ///< `mVertices` holds a board at all
+    uint64_t mPositionHash;       ///< Position the vertices were built for
+    bool mFlipped;                ///< Orientation the vertices were built for
+    int mHiddenSquare;            ///< Square left out of the vertices
+  };
+}
@@ -11,12 +11,14 @@
 
 #include <SFML/Graphics.hpp>
 #include "framework/Core.h"
+#include "framework/Move.h"
 #include "framework/Object.h"
 
 namespace chess
 {
   class Application;
   class Board;
+  class PieceLayer;
   class Piece;
   class King;
   class Pawn;
@@ -73,6 +75,21 @@ namespace chess
        */
       sf::Vector2f GetSpriteScale();
 
+      /**
+       * @brief Get the on-screen size of a piece, used to pick its texture resolution
+       * 
+       * @return unsigned int The piece height in pixels
+       */
+      unsigned int GetPieceSize();
+
+      /**
+       * @brief Get the scale that draws a piece texture at `GetPieceSize()`
+       * 
+       * @param texture The piece texture, whatever resolution it was loaded at
+       * @return sf::Vector2f The scale factor as a 2D vector
+       */
+      sf::Vector2f GetPieceScale(const sf::Texture& texture);
+
       /**
        * @brief Check if a piece has been moved
        * 
@@ -87,6 +104,28 @@ namespace chess
        */
       inline void SetPieceMoved(bool moved){ mPieceMoved = moved; }
 
+      /**
+       * @brief Request a redraw of the stage on the next loop iteration
+       */
+      inline void Invalidate(){ mNeedsRedraw = true; }
+
+      /**
+       * @brief Whether the stage or one of its widgets changed since the last call, and reset that
+       * 
+       * @return true if a new frame has to be rendered
+       */
+      bool ConsumeInvalidation();
+
+      /**
+       * @brief Whether the stage is waiting on something (an engine search, an animation)
+       * 
+       * The application ticks a stage at the full rate only while this is true,
+       * and otherwise sleeps until input arrives.
+       * 
+       * @return false by default
+       */
+      virtual bool NeedsTick() const;
+
       /**
        * @brief Spawn a HUD element
        * 
@@ -137,6 +176,11 @@ namespace chess
        */
       void RenderPieces();
       
+      /**
+       * @brief Render pieces one sprite at a time (fallback without a piece atlas)
+       */
+      void RenderPiecesIndividually();
+
       /**
        * @brief Render the HUD elements
        * 
@@ -158,10 +202,30 @@ namespace chess
       float GetCurrentEvaluation();
 
       /**
-       * @brief Calculates current evaluation of the position
+       * @brief Calculates current evaluation of the position and broadcasts it if it changed
        */
       void CalculateCurrentEvaluation();
 
+      /**
+       * @brief Per-tick hook for derived stages, called after the HUD tick
+       * 
+       * @param deltaTime Time elapsed since the last tick in seconds
+       */
+      virtual void Tick(float deltaTime);
+
+      /**
+       * @brief Whether white is the side to move
+       */
+      bool IsWhiteTurn() const;
+
+      /**
+       * @brief Play a move that did not come from the mouse (e.g. from the engine)
+       * 
+       * @param move Move to play; ignored unless it is legal
+       * @return true if the move was played
+       */
+      bool PlayMove(Move move);
+
       Delegate<float> mOnEvaluationUpdate; ///< Delegate to be called on evaluation update
 
     private:
@@ -190,6 +254,24 @@ namespace chess
        */
       bool CastlingPossible(ChessCoordinate kingCoordinate, ChessCoordinate rookCoordinate);
       
+      /**
+       * @brief Squares between king and rook that must be empty to castle
+       * 
+       * @param backRank Back rank of the castling side (1 or 8)
+       * @param kingSide True for kingside, false for queenside
+       * @return uint64_t Bitboard of the squares
+       */
+      static uint64_t CastlingEmptyMask(int backRank, bool kingSide);
+
+      /**
+       * @brief Squares the king crosses while castling
+       * 
+       * @param backRank Back rank of the castling side (1 or 8)
+       * @param kingSide True for kingside, false for queenside
+       * @return uint64_t Bitboard of the squares that must not be attacked
+       */
+      static uint64_t CastlingKingPathMask(int backRank, bool kingSide);
+      
       /**
        * @brief Perform kingside castling
        * 
@@ -300,8 +382,11 @@ namespace chess
       shared<Bishop> mBlackBishop;  ///< Black bishops
       shared<Pawn> mBlackPawn;      ///< Black pawns
 
+      shared<PieceLayer> mPieceLayer; ///< All pieces in one vertex array
+
       // Game state flags
       bool mPieceMoved;             ///< Whether a piece has been moved
+      bool mNeedsRedraw;            ///< Whether the board changed since the last rendered frame
 
       int mPieceOffsetX;            ///< X offset of the piece
       int mPieceOffsetY;            ///< Y offset of the piece
@@ -310,8 +395,6 @@ namespace chess
       ChessCoordinate mStartPose;   ///< Start position of the piece
       ChessCoordinate mEndPose;     ///< End position of the piece
 
-      bool mWhiteTurn;              ///< Whether it's white's turn
-
       bool mMouseDragging;          ///< Whether the mouse is dragging
       sf::Vector2i mMousePosition;  ///< Mouse position
 
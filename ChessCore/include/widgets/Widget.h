@@ -40,7 +40,7 @@ namespace chess
             sf::Angle GetWidgetRotaiton() { return mWidgetTransform.getRotation(); }
 
             /** @brief Show/hide this widget. */
-            void SetVisibility(bool newVisibility) { mIsVisible = newVisibility; }
+            void SetVisibility(bool newVisibility);
             /** @brief Whether the widget is visible. */
             bool GetVisibilty() { return mIsVisible; }
 
@@ -49,10 +49,21 @@ namespace chess
             /** @brief Convenience: center point of the current bounds. */
             sf::Vector2f GetCenterPosition();
 
+            /**
+             * @brief Whether any widget changed since the last call, and reset that.
+             *
+             * Widgets only exist on the one application window, so a single
+             * flag is enough for the stage to decide whether to redraw.
+             */
+            static bool ConsumeInvalidation();
+
         protected:
             /** @brief Construct a visible widget with identity transform. */
             Widget();
 
+            /** @brief Request a redraw after a visible change (text, color, layout). */
+            static void Invalidate() { sInvalidated = true; }
+
         private:
             /** @brief Derived classes implement actual drawing here. */
             virtual void Draw(sf::RenderWindow& windowRef);
@@ -63,5 +74,7 @@ namespace chess
 
             sf::Transformable mWidgetTransform; ///< Position/rotation state
             bool mIsVisible;                     ///< Visibility flag
+
+            static bool sInvalidated;            ///< A widget changed since the last frame
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "framework/AssetManager.h"
 #include "framework/Stage.h"
 #include "framework/ChessState.h"
+#include "framework/AttackTable.h"
 
 namespace chess
 {
@@ -17,14 +18,14 @@ namespace chess
     Bishop::Bishop(Stage *owningStage, bool whitePiece)
         :Piece{owningStage},
         mOwningStage{owningStage},
-        mWhiteBishopTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_bishop_png_shadow_1024px.png")},
-        mBlackBishopTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_bishop_png_shadow_1024px.png")},
+        mWhiteBishopTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_bishop_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
+        mBlackBishopTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_bishop_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
         mWhiteBishopSprite{*(mWhiteBishopTexture)},
         mBlackBishopSprite{*(mBlackBishopTexture)},
         mWhitePieces{whitePiece}
     {
-        mWhiteBishopSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-        mBlackBishopSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
+        mWhiteBishopSprite.setScale(mOwningStage->GetPieceScale(*mWhiteBishopTexture));
+        mBlackBishopSprite.setScale(mOwningStage->GetPieceScale(*mBlackBishopTexture));
     }
 
     /**
@@ -35,16 +36,8 @@ namespace chess
      */
     bool Bishop::MovePossible(ChessCoordinate &startCoordinate, ChessCoordinate &endCoordinate)
     {
-        int ranksForward = abs(endCoordinate.rank - startCoordinate.rank);
-        int filesRightward = abs(endCoordinate.file - startCoordinate.file);
-
-        if((ranksForward == filesRightward) && 
-            !PiecesInBetweenPath(startCoordinate,endCoordinate) &&
-            (ChessState::Get().GetPieceOnChessCoordinate(endCoordinate) == PieceType::invalid || isEnemy(endCoordinate)))
-        {
-            return true;
-        }
-        return false;
+        if(!startCoordinate.isValid() || !endCoordinate.isValid())return false;
+        return (GetTargets(startCoordinate) & SquareBit(ToSquare(endCoordinate))) != 0;
     }
 
     /**
@@ -100,36 +93,28 @@ namespace chess
     /**
      * @brief legal bishop moves along four diagonals from current pieceCoordinate.
      * @param pieceCoordinate Current square of the bishop.
-     * @return All reachable squares until blocked; includes one capture per ray.
+     * @param moves All reachable squares until blocked are appended here; includes one capture per ray.
      */
-    List<ChessCoordinate> Bishop::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)
+    void Bishop::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)
     {
-        List<ChessCoordinate> moves;
-        moves.reserve(32);
-
-        int offsetRank[4] = { -1,  -1,  1,  1};
-        int offsetFile[4] = {  1,  -1, -1,  1};
+        int from = ToSquare(pieceCoordinate);
+        uint64_t targets = GetTargets(pieceCoordinate);
 
-        for(int i = 0; i < 4; i++)
+        while(targets)
         {
-            ChessCoordinate iter{pieceCoordinate.rank, pieceCoordinate.file};
-            iter.rank += offsetRank[i];
-            iter.file += offsetFile[i];
-
-            while(iter.isValid())
-            {
-                if(ChessState::Get().GetPieceOnChessCoordinate(iter) != PieceType::invalid)
-                {
-                    if(isEnemy(iter))
-                        moves.emplace_back(iter);
-                    break;
-                }
-                moves.emplace_back(iter);
-                iter.rank += offsetRank[i];
-                iter.file += offsetFile[i];
-            }
+            moves.Add(Move{from, PopLowestSquare(targets)});
         }
-        return moves;
+    }
+
+    /**
+     * @brief Magic-bitboard lookup of the squares this bishop can move to.
+     * @param pieceCoordinate Current square of the bishop.
+     * @return Attacked squares minus those occupied by own pieces.
+     */
+    uint64_t Bishop::GetTargets(const ChessCoordinate &pieceCoordinate)
+    {
+        uint64_t attacks = AttackTable::Get().GetBishopAttacks(ToSquare(pieceCoordinate), ChessState::Get().GetOccupancy());
+        return attacks & ~ChessState::Get().GetOccupancy(mWhitePieces);
     }
     /**
      * @brief Get current sprite position for this bishop.
@@ -167,37 +152,4 @@ namespace chess
             mBlackBishopSprite.setOrigin({float(bound.position.x) ,float(bound.position.y)});
         }
     }
-
-    /**
-     * @brief Check if a target square contains an opponent piece.
-     */
-    bool Bishop::isEnemy(ChessCoordinate &endCoordinate)
-    {
-        return ((mWhitePieces && !Piece::GetPieceColor(ChessState::Get().GetPieceOnChessCoordinate(endCoordinate))) || (!mWhitePieces && Piece::GetPieceColor(ChessState::Get().GetPieceOnChessCoordinate(endCoordinate))));
-    }
-
-    /**
-     * @brief Determine if any piece lies between two diagonal squares.
-     * @return true if a blocking piece exists, false if the path is clear.
-     */
-    bool Bishop::PiecesInBetweenPath(ChessCoordinate& startCoordinate, ChessCoordinate& endCoordinate)
-    {
-        int offsetX = (endCoordinate.file - startCoordinate.file) > 0 ? 1 : -1 ;
-        int offsetY = (endCoordinate.rank - startCoordinate.rank) > 0 ? 1 : -1 ;
-
-        ChessCoordinate iterator{startCoordinate.rank,startCoordinate.file};
-        iterator.file += offsetX;
-        iterator.rank += offsetY;
-
-        while(iterator.isValid() && !(iterator == endCoordinate))
-        {
-            if(ChessState::Get().GetPieceOnChessCoordinate(iterator) != PieceType::invalid)
-            {
-                return true;
-            }
-            iterator.file += offsetX;
-            iterator.rank += offsetY;
-        }
-        return false;
-    }
 }
\ No newline at end of file
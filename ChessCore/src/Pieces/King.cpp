@@ -6,6 +6,7 @@
 #include "framework/AssetManager.h"
 #include "framework/Stage.h"
 #include "framework/ChessState.h"
+#include "framework/Bitboard.h"
 
 namespace chess
 {
@@ -17,14 +18,14 @@ namespace chess
     King::King(Stage *owningStage, bool whitePiece)
         :Piece{owningStage},
         mOwningStage{owningStage},
-        mWhiteKingTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_king_png_shadow_1024px.png")},
-        mBlackKingTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_king_png_shadow_1024px.png")},
+        mWhiteKingTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_king_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
+        mBlackKingTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_king_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
         mWhiteKingSprite{*(mWhiteKingTexture)},
         mBlackKingSprite{*(mBlackKingTexture)},
         mWhitePieces{whitePiece}
     {
-        mWhiteKingSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-        mBlackKingSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
+        mWhiteKingSprite.setScale(mOwningStage->GetPieceScale(*mWhiteKingTexture));
+        mBlackKingSprite.setScale(mOwningStage->GetPieceScale(*mBlackKingTexture));
     }
 
     /**
@@ -37,10 +38,11 @@ namespace chess
     {
         int ranksForward = abs(endCoordinate.rank - startCoordinate.rank);
         int filesRightward = abs(endCoordinate.file - startCoordinate.file);
+        uint64_t enemyAttacks = mWhitePieces ? ChessState::Get().GetBlackAttacks() : ChessState::Get().GetWhiteAttacks();
 
         if(((ranksForward == 1 && filesRightward == 1) || (ranksForward == 0 && filesRightward == 1 ) || (ranksForward == 1 && filesRightward == 0 )) && 
             (ChessState::Get().GetPieceOnChessCoordinate(endCoordinate) == PieceType::invalid || isEnemy(endCoordinate)) && 
-            ((mWhitePieces && (ChessState::Get().GetBlackAttackedSquares().find(endCoordinate) == ChessState::Get().GetBlackAttackedSquares().end())) || (!mWhitePieces && (ChessState::Get().GetWhiteAttackedSquares().find(endCoordinate) == ChessState::Get().GetWhiteAttackedSquares().end())) ) )
+            !(enemyAttacks & SquareBit(ToSquare(endCoordinate))) )
         {
             return true;
         }
@@ -100,13 +102,10 @@ namespace chess
     /**
      * @brief King moves to adjacent squares.
      * @param pieceCoordinate Current square of the king.
-     * @return Adjacent squares that pass `MovePossible` (excludes castling).
+     * @param moves Moves to adjacent squares that pass `MovePossible` are appended here (excludes castling).
      */
-    List<ChessCoordinate> King::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)
+    void King::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)
     {
-        List<ChessCoordinate> moves;
-        moves.reserve(8);
-
         int offsetRank[8] = { -1,  -1,  1,  1,  1, -1,  0,  0};
         int offsetFile[8] = {  1,  -1, -1,  1,  0,  0,  1, -1};
         
@@ -119,10 +118,9 @@ namespace chess
 
             if(end.isValid() && MovePossible(start,end))
             {
-                moves.emplace_back(end);
+                moves.Add(Move{ToSquare(start), ToSquare(end)});
             }
         }
-        return moves;
     }
     /**
      * @brief Check whether this king is currently in check.
@@ -130,16 +128,11 @@ namespace chess
      */
     bool King::IsInCheck()
     {
-        Set<ChessCoordinate,ChessCoordinateHashFunction> attackedSquares = mWhitePieces ? ChessState::Get().GetBlackAttackedSquares() : ChessState::Get().GetWhiteAttackedSquares();
-        if(mWhitePieces && attackedSquares.find(ChessState::Get().GetPiecePosiiton(PieceType::whiteKing)[0]) != attackedSquares.end())
-        {
-            return true;
-        }
-        else if(!mWhitePieces && attackedSquares.find(ChessState::Get().GetPiecePosiiton(PieceType::blackKing)[0]) != attackedSquares.end())
+        if(mWhitePieces)
         {
-            return true;
+            return (ChessState::Get().GetBlackAttacks() & ChessState::Get().GetPieceBitboard(PieceType::whiteKing)) != 0;
         }
-        return false;
+        return (ChessState::Get().GetWhiteAttacks() & ChessState::Get().GetPieceBitboard(PieceType::blackKing)) != 0;
     }
     /**
      * @brief Get current sprite position for this king.
@@ -17,14 +17,14 @@ namespace chess
     Knight::Knight(Stage *owningStage, bool whitePiece)
         :Piece{owningStage},
         mOwningStage{owningStage},
-        mWhiteKnightTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_knight_png_shadow_1024px.png")},
-        mBlackKnightTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_knight_png_shadow_1024px.png")},
+        mWhiteKnightTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_knight_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
+        mBlackKnightTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_knight_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
         mWhiteKnightSprite{*(mWhiteKnightTexture)},
         mBlackKnightSprite{*(mBlackKnightTexture)},
         mWhitePieces{whitePiece}
     {
-        mWhiteKnightSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-        mBlackKnightSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
+        mWhiteKnightSprite.setScale(mOwningStage->GetPieceScale(*mWhiteKnightTexture));
+        mBlackKnightSprite.setScale(mOwningStage->GetPieceScale(*mBlackKnightTexture));
     }
 
     /**
@@ -101,13 +101,10 @@ namespace chess
     /**
      * @brief Generate pseudo-legal knight moves to 8 potential targets.
      * @param pieceCoordinate Current square of the knight.
-     * @return Valid target squares that pass `MovePossible`.
+     * @param moves Moves to targets that pass `MovePossible` are appended here.
      */
-    List<ChessCoordinate> Knight::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)
+    void Knight::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)
     {
-        List<ChessCoordinate> moves;
-        moves.reserve(8);
-
         int offsetRank[8] = {  2,   2, -2, -2,  1, -1,  1, -1};
         int offsetFile[8] = {  1,  -1,  1, -1,  2,  2, -2, -2};
 
@@ -121,10 +118,9 @@ namespace chess
             
             if(end.isValid() && MovePossible(start,end))
             {
-                moves.emplace_back(end);
+                moves.Add(Move{ToSquare(start), ToSquare(end)});
             }
         }
-        return moves;
     }
     /**
      * @brief Get current sprite position for this knight.
@@ -17,21 +17,14 @@ namespace chess
     Pawn::Pawn(Stage *owningStage, bool whitePiece)
         :Piece{owningStage},
         mOwningStage{owningStage},
-        mWhitePawnTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_pawn_png_shadow_1024px.png")},
-        mBlackPawnTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_pawn_png_shadow_1024px.png")},
+        mWhitePawnTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_pawn_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
+        mBlackPawnTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_pawn_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
         mWhitePawnSprite{*(mWhitePawnTexture)},
         mBlackPawnSprite{*(mBlackPawnTexture)},
         mWhitePieces{whitePiece}
     {
-        mWhitePawnSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-        mBlackPawnSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-
-        // Initialising first move of every pawn to true
-        int rank = mWhitePieces ? 2 : 7;
-        for(int i = 0 ; i < 8; i++)
-        {
-            mFirstMove[ChessCoordinate{rank,(char)('a'+i)}] = true;
-        }
+        mWhitePawnSprite.setScale(mOwningStage->GetPieceScale(*mWhitePawnTexture));
+        mBlackPawnSprite.setScale(mOwningStage->GetPieceScale(*mBlackPawnTexture));
     }
 
     /**
@@ -45,9 +38,11 @@ namespace chess
         int pawnForwardMoves = mWhitePieces ? endCoordinate.rank - startCoordinate.rank : startCoordinate.rank - endCoordinate.rank ;
         if((startCoordinate.file == endCoordinate.file) && ChessState::Get().GetPieceOnChessCoordinate(endCoordinate) == PieceType::invalid)
         {
-            if(mFirstMove[startCoordinate])
+            // A pawn still on its starting rank has never moved, whatever position the game started from
+            if(startCoordinate.rank == (mWhitePieces ? 2 : 7))
             {
-                return (pawnForwardMoves == 1 || pawnForwardMoves == 2);
+                ChessCoordinate stepCoordinate{startCoordinate.rank + (mWhitePieces ? 1 : -1), startCoordinate.file};
+                return pawnForwardMoves == 1 || (pawnForwardMoves == 2 && ChessState::Get().GetPieceOnChessCoordinate(stepCoordinate) == PieceType::invalid);
             }
             else
             {
@@ -65,7 +60,7 @@ namespace chess
     }
 
     /**
-     * @brief Apply the move to `ChessState` for the correct side and update first-move flag.
+     * @brief Apply the move to `ChessState` for the correct side.
      */
     void Pawn::MakeMove(ChessCoordinate &startCoordinate, ChessCoordinate &endCoordinate)
     {
@@ -77,7 +72,6 @@ namespace chess
         {
             ChessState::Get().SetPiecePosition(PieceType::blackPawn,startCoordinate,endCoordinate);
         }
-        mFirstMove[endCoordinate] = false;
     }
 
     /**
@@ -117,15 +111,17 @@ namespace chess
 
     /**
      * @brief Generate pseudo-legal pawn moves (push/captures/double on first move).
+     *
+     * Moves onto the last rank are added once per promotion piece.
      * @param pieceCoordinate Current square of the pawn.
-     * @return Candidate targets validated by `MovePossible`.
+     * @param moves Candidate moves validated by `MovePossible` are appended here.
      */
-    List<ChessCoordinate> Pawn::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)
+    void Pawn::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)
     {
-        List<ChessCoordinate> moves;
-        moves.reserve(4);
-
         ChessCoordinate start{pieceCoordinate.rank, pieceCoordinate.file};
+        int from = ToSquare(start);
+        int lastRank = mWhitePieces ? 8 : 1;
+        PieceType promotions[4] = {PieceType::whiteQueen, PieceType::whiteRook, PieceType::whiteBishop, PieceType::whiteKnight};
         std::array<int,6> offsetRank;
         std::array<int,6> offsetFile;
         
@@ -145,13 +141,26 @@ namespace chess
             ChessCoordinate end{pieceCoordinate.rank, pieceCoordinate.file};
             end.rank += offsetRank[i];
             end.file += offsetFile[i];
-            if(MovePossible(start,end))
+            if(!end.isValid() || !MovePossible(start,end))
+                continue;
+
+            int to = ToSquare(end);
+            if(end.rank == lastRank)
+            {
+                for(PieceType promotion : promotions)
+                {
+                    moves.Add(Move{from, to, MoveFlag::Promotion, promotion});
+                }
+            }
+            else if(end.file != start.file && ChessState::Get().GetPieceOnChessCoordinate(end) == PieceType::invalid)
             {
-                moves.emplace_back(end);
+                moves.Add(Move{from, to, MoveFlag::EnPassant});
+            }
+            else
+            {
+                moves.Add(Move{from, to});
             }
         }
-
-        return moves;
     }
 
     /**
@@ -233,30 +242,21 @@ namespace chess
     }
 
     /**
-     * @brief Determine if en passant capture is legal given last move and positions.
+     * @brief Determine if en passant capture is legal given the position's en passant square.
      * @param startCoordinate Pawn start square.
      * @param endCoordinate Target capture destination behind the moved pawn.
-     * @return true if the last move was a 2-step adjacent pawn and all constraints match.
+     * @return true if the destination is the en passant square and the capture is a diagonal step forward.
      */
     bool Pawn::EnPassantPossible(ChessCoordinate startCoordinate, ChessCoordinate endCoordinate)
     {
       if((mWhitePieces && ChessState::Get().GetPieceOnChessCoordinate(startCoordinate) != PieceType::whitePawn) || (!mWhitePieces && ChessState::Get().GetPieceOnChessCoordinate(startCoordinate) != PieceType::blackPawn))
         return false;
       
-      List<ChessCoordinate> lastMove = ChessState::Get().GetLastPlayedMove();
-      if(lastMove.size()<2)return false;
-      if(mWhitePieces && lastMove[0].rank == 7 && lastMove[1].rank == 5 && startCoordinate.rank == 5 && endCoordinate.rank == 6 
-        && lastMove[0].file == lastMove[1].file && endCoordinate.file == lastMove[0].file
-        && abs(startCoordinate.file - endCoordinate.file) == 1 && abs(startCoordinate.file - lastMove[0].file) == 1)
-      {
-        return true;
-      }
-      else if(!mWhitePieces && lastMove[0].rank == 2 && lastMove[1].rank == 4 && startCoordinate.rank == 4 && endCoordinate.rank == 3 
-        && lastMove[0].file == lastMove[1].file && endCoordinate.file == lastMove[0].file
-        && abs(startCoordinate.file - endCoordinate.file) == 1 && abs(startCoordinate.file - lastMove[0].file) == 1)
-      {
-        return true;
-      }
+      int enPassantSquare = ChessState::Get().GetPosition().GetEnPassantSquare();
+      if(enPassantSquare == NO_SQUARE || !endCoordinate.isValid() || ToSquare(endCoordinate) != enPassantSquare)
         return false;
+
+      return abs(startCoordinate.file - endCoordinate.file) == 1
+        && endCoordinate.rank - startCoordinate.rank == (mWhitePieces ? 1 : -1);
     }
 }
\ No newline at end of file
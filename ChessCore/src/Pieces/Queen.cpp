@@ -6,6 +6,7 @@
 #include "framework/AssetManager.h"
 #include "framework/Stage.h"
 #include "framework/ChessState.h"
+#include "framework/AttackTable.h"
 
 namespace chess
 {
@@ -17,14 +18,14 @@ namespace chess
     Queen::Queen(Stage *owningStage, bool whitePiece)
         :Piece{owningStage},
         mOwningStage{owningStage},
-        mWhiteQueenTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_queen_png_shadow_1024px.png")},
-        mBlackQueenTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_queen_png_shadow_1024px.png")},
+        mWhiteQueenTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_queen_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
+        mBlackQueenTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_queen_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
         mWhiteQueenSprite{*(mWhiteQueenTexture)},
         mBlackQueenSprite{*(mBlackQueenTexture)},
         mWhitePieces{whitePiece}
     {
-        mWhiteQueenSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-        mBlackQueenSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
+        mWhiteQueenSprite.setScale(mOwningStage->GetPieceScale(*mWhiteQueenTexture));
+        mBlackQueenSprite.setScale(mOwningStage->GetPieceScale(*mBlackQueenTexture));
     }
 
     /**
@@ -35,16 +36,8 @@ namespace chess
      */
     bool Queen::MovePossible(ChessCoordinate &startCoordinate, ChessCoordinate &endCoordinate)
     {
-        int ranksForward = abs(endCoordinate.rank - startCoordinate.rank);
-        int filesRightward = abs(endCoordinate.file - startCoordinate.file);
-
-        if(((ranksForward == filesRightward) || (ranksForward == 0 && filesRightward > 0 ) || (ranksForward > 0 && filesRightward == 0 )) && 
-            !PiecesInBetweenPath(startCoordinate,endCoordinate) &&
-            (ChessState::Get().GetPieceOnChessCoordinate(endCoordinate) == PieceType::invalid || isEnemy(endCoordinate)))
-        {
-            return true;
-        }
-        return false;
+        if(!startCoordinate.isValid() || !endCoordinate.isValid())return false;
+        return (GetTargets(startCoordinate) & SquareBit(ToSquare(endCoordinate))) != 0;
     }
 
     /**
@@ -100,36 +93,28 @@ namespace chess
     /**
      * @brief Legal queen moves in 8 directions.
      * @param pieceCoordinate Current square of the queen.
-     * @return All reachable squares until blocked; includes one capture per ray.
+     * @param moves All reachable squares until blocked are appended here; includes one capture per ray.
      */
-    List<ChessCoordinate> Queen::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)
+    void Queen::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)
     {
-        List<ChessCoordinate> moves;
-        moves.reserve(32);
-
-        int offsetRank[8] = { -1,  -1,  1,  1,  0,   0,  1, -1};
-        int offsetFile[8] = {  1,  -1, -1,  1,  1,  -1,  0,  0};
+        int from = ToSquare(pieceCoordinate);
+        uint64_t targets = GetTargets(pieceCoordinate);
 
-        for(int i = 0; i < 8; i++)
+        while(targets)
         {
-            ChessCoordinate iter{pieceCoordinate.rank, pieceCoordinate.file};
-            iter.rank += offsetRank[i];
-            iter.file += offsetFile[i];
-
-            while(iter.isValid())
-            {
-                if(ChessState::Get().GetPieceOnChessCoordinate(iter) != PieceType::invalid)
-                {
-                    if(isEnemy(iter))
-                        moves.emplace_back(iter);
-                    break;
-                }
-                moves.emplace_back(iter);
-                iter.rank += offsetRank[i];
-                iter.file += offsetFile[i];
-            }
+            moves.Add(Move{from, PopLowestSquare(targets)});
         }
-        return moves;
+    }
+
+    /**
+     * @brief Magic-bitboard lookup of the squares this queen can move to.
+     * @param pieceCoordinate Current square of the queen.
+     * @return Attacked squares minus those occupied by own pieces.
+     */
+    uint64_t Queen::GetTargets(const ChessCoordinate &pieceCoordinate)
+    {
+        uint64_t attacks = AttackTable::Get().GetQueenAttacks(ToSquare(pieceCoordinate), ChessState::Get().GetOccupancy());
+        return attacks & ~ChessState::Get().GetOccupancy(mWhitePieces);
     }
     /**
      * @brief Get current sprite position for this queen.
@@ -167,46 +152,4 @@ namespace chess
             mBlackQueenSprite.setOrigin({float(bound.position.x) ,float(bound.position.y)});
         }
     }
-    /**
-     * @brief Check if a target square contains an opponent piece.
-     */
-    bool Queen::isEnemy(ChessCoordinate &endCoordinate)
-    {
-        return ((mWhitePieces && !Piece::GetPieceColor(ChessState::Get().GetPieceOnChessCoordinate(endCoordinate))) || (!mWhitePieces && Piece::GetPieceColor(ChessState::Get().GetPieceOnChessCoordinate(endCoordinate))));
-    }
-
-    /**
-     * @brief Determine if any piece blocks the path to destination.
-     * Normalizes direction and steps one square at a time until end.
-     */
-    bool Queen::PiecesInBetweenPath(ChessCoordinate &startCoordinate, ChessCoordinate &endCoordinate)
-    {
-        int offsetX = (endCoordinate.file - startCoordinate.file);
-        int offsetY = (endCoordinate.rank - startCoordinate.rank);
-
-        if(offsetX > 0)
-            offsetX = 1;
-        else if(offsetX < 0)
-            offsetX = -1;
-
-        if(offsetY > 0)
-            offsetY = 1;
-        else if(offsetY < 0)
-            offsetY = -1;
-
-        ChessCoordinate iterator{startCoordinate.rank,startCoordinate.file};
-        iterator.file += offsetX;
-        iterator.rank += offsetY;
-
-        while(iterator.isValid() && !(iterator == endCoordinate))
-        {
-            if(ChessState::Get().GetPieceOnChessCoordinate(iterator) != PieceType::invalid)
-            {
-                return true;
-            }
-            iterator.file += offsetX;
-            iterator.rank += offsetY;
-        }
-        return false;
-    }
 }
\ No newline at end of file
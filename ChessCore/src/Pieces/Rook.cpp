@@ -6,6 +6,7 @@
 #include "framework/AssetManager.h"
 #include "framework/Stage.h"
 #include "framework/ChessState.h"
+#include "framework/AttackTable.h"
 
 namespace chess
 {
@@ -17,14 +18,14 @@ namespace chess
     Rook::Rook(Stage *owningStage, bool whitePiece)
         :Piece{owningStage},
         mOwningStage{owningStage},
-        mWhiteRookTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_rook_png_shadow_1024px.png")},
-        mBlackRookTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_rook_png_shadow_1024px.png")},
+        mWhiteRookTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_rook_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
+        mBlackRookTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_rook_png_shadow_1024px.png", owningStage->GetPieceSize(), true)},
         mWhiteRookSprite{*(mWhiteRookTexture)},
         mBlackRookSprite{*(mBlackRookTexture)},
         mWhitePieces{whitePiece}
     {
-        mWhiteRookSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
-        mBlackRookSprite.setScale(mOwningStage->GetSpriteScale() - sf::Vector2f{0.01,0.01});
+        mWhiteRookSprite.setScale(mOwningStage->GetPieceScale(*mWhiteRookTexture));
+        mBlackRookSprite.setScale(mOwningStage->GetPieceScale(*mBlackRookTexture));
     }
 
     /**
@@ -35,16 +36,8 @@ namespace chess
      */
     bool Rook::MovePossible(ChessCoordinate &startCoordinate, ChessCoordinate &endCoordinate)
     {
-        int ranksForward = abs(endCoordinate.rank - startCoordinate.rank);
-        int filesRightward = abs(endCoordinate.file - startCoordinate.file);
-
-        if(((ranksForward == 0 && filesRightward > 0 ) || (ranksForward > 0 && filesRightward == 0 )) &&
-            !PiecesInBetweenPath(startCoordinate,endCoordinate) &&
-            (ChessState::Get().GetPieceOnChessCoordinate(endCoordinate) == PieceType::invalid || isEnemy(endCoordinate)))
-            {
-                return true;
-            }
-        return false;
+        if(!startCoordinate.isValid() || !endCoordinate.isValid())return false;
+        return (GetTargets(startCoordinate) & SquareBit(ToSquare(endCoordinate))) != 0;
     }
 
     /**
@@ -100,36 +93,28 @@ namespace chess
     /**
      * @brief Legal rook moves along ranks/files.
      * @param pieceCoordinate Current square of the rook.
-     * @return All reachable squares until blocked; includes one capture per ray.
+     * @param moves All reachable squares until blocked are appended here; includes one capture per ray.
      */
-    List<ChessCoordinate> Rook::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate)
+    void Rook::GetAllPossibleMoves(const ChessCoordinate pieceCoordinate, MoveList& moves)
     {
-        List<ChessCoordinate> moves;
-        moves.reserve(32);
-
-        int offsetRank[4] = {  0,   0,  1, -1};
-        int offsetFile[4] = {  1,  -1,  0,  0};
+        int from = ToSquare(pieceCoordinate);
+        uint64_t targets = GetTargets(pieceCoordinate);
 
-        for(int i = 0; i < 4; i++)
+        while(targets)
         {
-            ChessCoordinate iter{pieceCoordinate.rank, pieceCoordinate.file};
-            iter.rank += offsetRank[i];
-            iter.file += offsetFile[i];
-
-            while(iter.isValid())
-            {
-                if(ChessState::Get().GetPieceOnChessCoordinate(iter) != PieceType::invalid)
-                {
-                    if(isEnemy(iter))
-                        moves.emplace_back(iter);
-                    break;
-                }
-                moves.emplace_back(iter);
-                iter.rank += offsetRank[i];
-                iter.file += offsetFile[i];
-            }
+            moves.Add(Move{from, PopLowestSquare(targets)});
         }
-        return moves;
+    }
+
+    /**
+     * @brief Magic-bitboard lookup of the squares this rook can move to.
+     * @param pieceCoordinate Current square of the rook.
+     * @return Attacked squares minus those occupied by own pieces.
+     */
+    uint64_t Rook::GetTargets(const ChessCoordinate &pieceCoordinate)
+    {
+        uint64_t attacks = AttackTable::Get().GetRookAttacks(ToSquare(pieceCoordinate), ChessState::Get().GetOccupancy());
+        return attacks & ~ChessState::Get().GetOccupancy(mWhitePieces);
     }
     
     /**
@@ -168,39 +153,4 @@ namespace chess
             mBlackRookSprite.setOrigin({float(bound.position.x) ,float(bound.position.y)});
         }
     }
-    /**
-     * @brief Check if a target square contains an opponent piece.
-     */
-    bool chess::Rook::isEnemy(ChessCoordinate &endCoordinate)
-    {
-        return ((mWhitePieces && !Piece::GetPieceColor(ChessState::Get().GetPieceOnChessCoordinate(endCoordinate))) || (!mWhitePieces && Piece::GetPieceColor(ChessState::Get().GetPieceOnChessCoordinate(endCoordinate))));
-    }
-
-    /**
-     * @brief Determine if any piece blocks the path to destination.
-     * Normalizes direction along one axis and steps until end.
-     */
-    bool chess::Rook::PiecesInBetweenPath(ChessCoordinate &startCoordinate, ChessCoordinate &endCoordinate)
-    {
-        int offsetX = (endCoordinate.file - startCoordinate.file);
-        int offsetY = (endCoordinate.rank - startCoordinate.rank);
-
-        if(offsetX == 0)offsetY = offsetY > 0 ? 1 : -1;
-        if(offsetY == 0)offsetX = offsetX > 0 ? 1 : -1;
-
-        ChessCoordinate iterator{startCoordinate.rank,startCoordinate.file};
-        iterator.file += offsetX;
-        iterator.rank += offsetY;
-
-        while(iterator.isValid() && !(iterator == endCoordinate))
-        {
-            if(ChessState::Get().GetPieceOnChessCoordinate(iterator) != PieceType::invalid)
-            {
-                return true;
-            }
-            iterator.file += offsetX;
-            iterator.rank += offsetY;
-        }
-        return false;
-    }
 }
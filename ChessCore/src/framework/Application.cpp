@@ -8,6 +8,8 @@
  */
 
 #include "framework/Application.h"
+#include <algorithm>
+#include <cmath>
 
 namespace chess {
   /**
@@ -21,8 +23,10 @@ namespace chess {
   Application::Application(unsigned int windowWidth, unsigned int windowHeight,
                          const std::string &windowTitle, std::uint32_t windowStyle)
       : mWindow{sf::VideoMode({windowWidth, windowHeight}), windowTitle, windowStyle},
-        mTargetFrameRate{120.f},
+        mFramePacing{},
         mTickClock{},
+        mFrameClock{},
+        mIdleTickInterval{sf::seconds(0.5f)},
         mCurrentStage{}
   {
 
@@ -32,58 +36,73 @@ namespace chess {
    * @brief Main game loop
    * 
    * This method contains the main game loop which handles:
-   * - Event processing
-   * - Fixed time step updates
-   * - Rendering
    * - Stage initialization
+   * - Fixed time step updates, at most `mMaxCatchUpTicks` per iteration
+   * - Rendering, only when the stage or a widget was invalidated and the
+   *   frame rate limit allows it
+   * - Event processing, sleeping in `waitEvent` until input arrives
+   * 
+   * Ticks and frames are scheduled independently: a slow frame delays the
+   * next ticks but never causes extra renders, and a backlog bigger than
+   * the catch-up cap is dropped instead of compounding.
+   * 
+   * While the stage reports `NeedsTick()` (a search or analysis running)
+   * the wait ends at the next tick so results are polled at the tick
+   * rate. Otherwise the loop sleeps until input, waking every
+   * `mIdleTickInterval` for a single tick, and the idle time is not
+   * simulated afterwards.
    */
   void Application::Run() 
   {
     mTickClock.restart();
-    float accumalatedTime = 0.f;
-    float targetDeltaTime = 1.f / mTargetFrameRate;
+    mFrameClock.restart();
+    float accumalatedTime = 1.f / mFramePacing.mTickRate;
+    bool framePending = false;
 
     while (mWindow.isOpen()) 
     {
-      // Process all pending events
-      while (const std::optional event = mWindow.pollEvent()) 
+      float targetDeltaTime = 1.f / mFramePacing.mTickRate;
+
+      if(mCurrentStage)
       {
-        if (event->is<sf::Event::Closed>()) 
-        {
-          QuitApplication();
-        }
-        else
-        {
-          DispathEvent(event);
-        }
+        mCurrentStage->BeginPlayInternal();
       }
 
-      float frameDeltaTime = mTickClock.restart().asSeconds();
-      accumalatedTime += frameDeltaTime;
-      
       // Fixed time step update loop
-      while(accumalatedTime > targetDeltaTime)
+      int ticks = 0;
+      while(accumalatedTime >= targetDeltaTime && ticks < mFramePacing.mMaxCatchUpTicks)
       {
           accumalatedTime -= targetDeltaTime;
           TickInternal(targetDeltaTime);
-          Render();
+          ticks++;
       }
-
-      if(mCurrentStage)
+      if(accumalatedTime >= targetDeltaTime)
       {
-        mCurrentStage->BeginPlayInternal();
+        accumalatedTime = std::fmod(accumalatedTime, targetDeltaTime);
       }
 
-      // Render only if piece is moved
-      // if(mCurrentStage && mCurrentStage->IsPieceMoved())
-      // {
-      //   mWindow.clear();
+      if(mCurrentStage && mCurrentStage->ConsumeInvalidation())
+      {
+        framePending = true;
+      }
+      if(framePending && TimeUntilNextFrame() == sf::Time::Zero)
+      {
+        Render();
+        mFrameClock.restart();
+        framePending = false;
+      }
 
-      //   Render();
-      //   mCurrentStage->SetPieceMoved(false);
+      bool ticking = mCurrentStage && mCurrentStage->NeedsTick();
+      sf::Time timeout = ticking ? sf::seconds(targetDeltaTime - accumalatedTime) : mIdleTickInterval;
+      if(framePending)
+      {
+        timeout = std::min(timeout, TimeUntilNextFrame());
+      }
+      // A zero timeout would wait forever
+      WaitForEvents(std::max(timeout, sf::milliseconds(1)));
 
-      //   mWindow.display();
-      // }
+      float frameDeltaTime = mTickClock.restart().asSeconds();
+      accumalatedTime = ticking ? accumalatedTime + frameDeltaTime : targetDeltaTime;
     }
   }
 
@@ -100,6 +119,22 @@ namespace chess {
     mWindow.display();
   }
 
+  /**
+   * @brief Applies new frame pacing
+   * 
+   * Vertical sync throttles `display()` itself, so the frame rate limit
+   * is ignored while it is on.
+   * 
+   * @param framePacing The new pacing, used from the next loop iteration
+   */
+  void Application::SetFramePacing(const FramePacing &framePacing)
+  {
+    mFramePacing = framePacing;
+    mFramePacing.mTickRate = std::max(mFramePacing.mTickRate, 1.f);
+    mFramePacing.mMaxCatchUpTicks = std::max(mFramePacing.mMaxCatchUpTicks, 1);
+    mWindow.setVerticalSyncEnabled(mFramePacing.mVerticalSync);
+  }
+
   /**
    * @brief Gets a reference to the render window
    * 
@@ -171,6 +206,46 @@ namespace chess {
       return false;
   }
 
+  /**
+   * @brief Waits for the first event, then drains the queue without blocking
+   * 
+   * @param timeout Longest time to wait for the first event
+   */
+  void Application::WaitForEvents(sf::Time timeout)
+  {
+    if (const std::optional event = mWindow.waitEvent(timeout)) 
+    {
+      HandleWindowEvent(event);
+      while (const std::optional pending = mWindow.pollEvent()) 
+      {
+        HandleWindowEvent(pending);
+      }
+    }
+  }
+
+  /**
+   * @brief Handles one window event
+   * 
+   * The window contents may be stale after a resize or when it regains
+   * focus, so those redraw the stage even though no stage handles them.
+   * 
+   * @param event The SFML event to handle
+   */
+  void Application::HandleWindowEvent(const std::optional<sf::Event> &event)
+  {
+    if (event->is<sf::Event::Closed>()) 
+    {
+      QuitApplication();
+      return;
+    }
+
+    if(mCurrentStage && (event->is<sf::Event::Resized>() || event->is<sf::Event::FocusGained>()))
+    {
+      mCurrentStage->Invalidate();
+    }
+    DispathEvent(event);
+  }
+
   /**
    * @brief Internal method to update the current stage
    * 
@@ -193,4 +268,18 @@ namespace chess {
     if(mCurrentStage)
       mCurrentStage->Render();
   }
+
+  /**
+   * @brief Time left before the frame rate limit allows the next frame
+   * 
+   * @return sf::Time Zero if a frame may be presented now
+   */
+  sf::Time Application::TimeUntilNextFrame() const
+  {
+    if(mFramePacing.mVerticalSync || mFramePacing.mFrameRateLimit <= 0.f)
+      return sf::Time::Zero;
+
+    sf::Time remaining = sf::seconds(1.f / mFramePacing.mFrameRateLimit) - mFrameClock.getElapsedTime();
+    return std::max(remaining, sf::Time::Zero);
+  }
 } // namespace chess
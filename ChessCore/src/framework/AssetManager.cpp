@@ -4,9 +4,56 @@
  */
 
 #include"framework/AssetManager.h"
+#include<cctype>
+#include<filesystem>
 
 namespace chess
 {
+  namespace
+  {
+    /** @brief Resolutions the PNG sets are exported in, smallest first. */
+    constexpr unsigned int SIZE_VARIANTS[] = {128, 256, 512, 1024};
+
+    /**
+     * @brief Half-size copy of an image, each pixel the average of a 2x2 block.
+     *
+     * Colors are weighted by alpha so transparent pixels do not darken the
+     * edges of a piece.
+     */
+    sf::Image HalveImage(const sf::Image& image)
+    {
+      sf::Vector2u size{image.getSize().x / 2, image.getSize().y / 2};
+      unsigned int sourceWidth = image.getSize().x;
+      const std::uint8_t* source = image.getPixelsPtr();
+      List<std::uint8_t> pixels(static_cast<size_t>(size.x) * size.y * 4);
+
+      for(unsigned int y = 0; y < size.y; y++)
+      {
+        for(unsigned int x = 0; x < size.x; x++)
+        {
+          unsigned int color[3] = {0, 0, 0};
+          unsigned int alpha = 0;
+          for(unsigned int dy = 0; dy < 2; dy++)
+          {
+            for(unsigned int dx = 0; dx < 2; dx++)
+            {
+              const std::uint8_t* pixel = source + (static_cast<size_t>(2 * y + dy) * sourceWidth + 2 * x + dx) * 4;
+              for(int c = 0; c < 3; c++)
+                color[c] += pixel[c] * pixel[3];
+              alpha += pixel[3];
+            }
+          }
+
+          std::uint8_t* target = pixels.data() + (static_cast<size_t>(y) * size.x + x) * 4;
+          for(int c = 0; c < 3; c++)
+            target[c] = static_cast<std::uint8_t>(alpha > 0 ? color[c] / alpha : 0);
+          target[3] = static_cast<std::uint8_t>(alpha / 4);
+        }
+      }
+      return sf::Image{size, pixels.data()};
+    }
+  }
+
   unique<AssetManager> AssetManager::mAssetManager{nullptr};
 
   /**
@@ -47,6 +94,98 @@ namespace chess
     return LoadAssets(texturePath, mLoadedTextures); 
   }
 
+  /**
+   * @brief Load the smallest adequate variant, downsample it and optionally mipmap it.
+   *
+   * @param texturePath Relative path from the configured root directory.
+   * @param targetSize Largest on-screen side in pixels; 0 keeps the full resolution.
+   * @param mipmapped Whether to smooth the texture and generate mipmaps.
+   * @return shared<sf::Texture> Shared pointer to the loaded texture, or nullptr on failure.
+   */
+  shared<sf::Texture> AssetManager::LoadTexture(const std::string &texturePath, unsigned int targetSize, bool mipmapped)
+  {
+    if(targetSize == 0 && !mipmapped) return LoadTexture(texturePath);
+    if(texturePath.size() == 0) return shared<sf::Texture>{nullptr};
+
+    std::string key = texturePath + '@' + std::to_string(targetSize) + (mipmapped ? "+mip" : "");
+    auto found = mLoadedTextures.find(key);
+    if(found != mLoadedTextures.end())
+    {
+      return found->second;
+    }
+
+    sf::Image image;
+    if(!image.loadFromFile(mRootDir + FindSizeVariant(texturePath, targetSize)))
+    {
+      return nullptr;
+    }
+    while(targetSize > 0 && image.getSize().x >= 2 * targetSize && image.getSize().y >= 2 * targetSize)
+    {
+      image = HalveImage(image);
+    }
+
+    shared<sf::Texture> newTexture{new sf::Texture};
+    if(!newTexture->loadFromImage(image))
+    {
+      return nullptr;
+    }
+    if(mipmapped)
+    {
+      newTexture->setSmooth(true);
+      // Without mipmap support the texture is still smooth, just blurrier when scaled far down
+      (void)newTexture->generateMipmap();
+    }
+    return mLoadedTextures[key] = newTexture;
+  }
+
+  /**
+   * @brief Swap the "<N>px" size tag in both the folder and the file name.
+   *
+   * Variants that were not exported (missing files) are skipped, so the
+   * next larger one, or the original, is used instead.
+   */
+  std::string AssetManager::FindSizeVariant(const std::string &texturePath, unsigned int targetSize) const
+  {
+    size_t tagEnd = texturePath.find("px/");
+    if(tagEnd == std::string::npos)
+    {
+      return texturePath;
+    }
+    size_t tagStart = tagEnd;
+    while(tagStart > 0 && std::isdigit(static_cast<unsigned char>(texturePath[tagStart - 1])))
+    {
+      tagStart--;
+    }
+    if(tagStart == tagEnd)
+    {
+      return texturePath;
+    }
+
+    std::string sizeTag = texturePath.substr(tagStart, tagEnd + 2 - tagStart);
+    unsigned int pathSize = static_cast<unsigned int>(std::stoul(sizeTag));
+    for(unsigned int variant : SIZE_VARIANTS)
+    {
+      if(variant >= pathSize)
+        break;
+      if(variant < targetSize)
+        continue;
+
+      std::string variantPath = texturePath;
+      std::string variantTag = std::to_string(variant) + "px";
+      for(size_t at = variantPath.find(sizeTag); at != std::string::npos; at = variantPath.find(sizeTag, at + variantTag.size()))
+      {
+        variantPath.replace(at, sizeTag.size(), variantTag);
+      }
+
+      std::error_code error;
+      if(std::filesystem::is_regular_file(mRootDir + variantPath, error))
+      {
+        return variantPath;
+      }
+    }
+    return texturePath;
+  }
+
   /**
    * @brief Load a font from disk or return a cached one.
    *
@@ -6,9 +6,26 @@
 #include"framework/Board.h"
 #include"framework/AssetManager.h" 
 #include"framework/Stage.h"
+#include<algorithm>
+#include<cmath>
 
 namespace chess
 {
+  namespace
+  {
+    /** @brief On-screen side of a square, the size its texture is loaded for. */
+    unsigned int SquareSize(const sf::Vector2f& boardDimensions)
+    {
+      return static_cast<unsigned int>(std::ceil(std::max(boardDimensions.x, boardDimensions.y) / 8.f));
+    }
+
+    const char* LIGHT_SQUARE_TEXTURE = "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/square brown light_png_shadow_1024px.png";
+    const char* DARK_SQUARE_TEXTURE = "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/square brown dark_png_shadow_1024px.png";
+
+    /** @brief Bakes tried before the board settles for drawing its squares one by one. */
+    constexpr int MAX_BAKE_ATTEMPTS = 2;
+  }
+
   /**
    * @brief Construct a new Board and initialize metrics and sprites.
    *
@@ -19,23 +36,52 @@ namespace chess
     :mOwingStage{owningStage},
     mBoardStart{boardStart},
     mBoardDimensions{boardDimensions},
-    mWhiteTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/square brown dark_png_shadow_1024px.png")},
-    mBlackTexture{AssetManager::Get().LoadTexture("JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/square brown light_png_shadow_1024px.png")},
+    mWhiteTexture{AssetManager::Get().LoadTexture(DARK_SQUARE_TEXTURE, SquareSize(boardDimensions), true)},
+    mBlackTexture{AssetManager::Get().LoadTexture(LIGHT_SQUARE_TEXTURE, SquareSize(boardDimensions), true)},
     mWhiteSquaresSprite{*(mWhiteTexture)},
     mBlackSquaresSprite{*(mBlackTexture)},
     mScaleX{1.f},
     mScaleY{1.f},
     mOffsetX{102},
-    mOffsetY{102}
+    mOffsetY{102},
+    mBakedBoard{},
+    mBakedBoardSprite{mBakedBoard.getTexture()},
+    mBakeDirty{true},
+    mBakeFailures{0}
   {
     CalculateSquareOffset();
-    RefreshBoard();
   }
 
   /**
-   * @brief Redraw the entire board using current scale and offsets.
+   * @brief Draw the board as one sprite, baking it first if needed.
+   *
+   * A failed bake is not final: the squares are drawn one by one this time
+   * and the bake is tried again on the next draw, up to `MAX_BAKE_ATTEMPTS`
+   * times. After that the squares are always drawn one by one.
    */
   void Board::RefreshBoard()
+  {
+    if(mBakeDirty && mBakeFailures < MAX_BAKE_ATTEMPTS)
+    {
+      mBakeDirty = !BakeBoard();
+      if(mBakeDirty)
+        mBakeFailures++;
+    }
+
+    if(mBakeDirty)
+    {
+      DrawSquares(mOwingStage->GetWindow(), mBoardStart);
+      return;
+    }
+    mOwingStage->GetWindow().draw(mBakedBoardSprite);
+  }
+
+  /**
+   * @brief Draw the 8x8 grid of square sprites.
+   * @param target Window or render texture to draw to.
+   * @param origin Top-left corner of the board on `target`.
+   */
+  void Board::DrawSquares(sf::RenderTarget &target, const sf::Vector2f &origin)
   {
     mBlackSquaresSprite.setScale({mScaleX,mScaleY});
     mWhiteSquaresSprite.setScale({mScaleX,mScaleY});
@@ -46,37 +92,31 @@ namespace chess
       bool light_square = i % 2 == 0 ? false : true;
       for(int j = 0; j < 8 ; j++)
       {
-        if(light_square)
-        {
-          RenderWhiteSquare({ mBoardStart.x + i * mOffsetX , mBoardStart.y + j * mOffsetY });
-        }
-        else
-        {
-          RenderBlackSquare({ mBoardStart.x + i * mOffsetX , mBoardStart.y + j * mOffsetY });
-        }
+        sf::Sprite& square = light_square ? mWhiteSquaresSprite : mBlackSquaresSprite;
+        square.setPosition({ origin.x + i * mOffsetX , origin.y + j * mOffsetY });
+        target.draw(square);
         light_square = !light_square;
       }
     }
   }
 
   /**
-   * @brief Draw a dark/black square at a position.
-   * @param position Top-left position in window coordinates.
+   * @brief Render the squares once into `mBakedBoard` and point the board sprite at it.
+   * @return false if the render texture could not be created.
    */
-  void Board::RenderBlackSquare(const sf::Vector2f &position)
+  bool Board::BakeBoard()
   {
-    mBlackSquaresSprite.setPosition(position);
-    mOwingStage->GetWindow().draw(mBlackSquaresSprite);
-  }
+    sf::Vector2u size{static_cast<unsigned int>(std::ceil(8 * mOffsetX)), static_cast<unsigned int>(std::ceil(8 * mOffsetY))};
+    if(!mBakedBoard.resize(size))
+      return false;
 
-  /**
-   * @brief Draw a light/white square at a position.
-   * @param position Top-left position in window coordinates.
-   */
-  void Board::RenderWhiteSquare(const sf::Vector2f &position)
-  {
-    mWhiteSquaresSprite.setPosition(position);
-    mOwingStage->GetWindow().draw(mWhiteSquaresSprite);
+    mBakedBoard.clear(sf::Color::Transparent);
+    DrawSquares(mBakedBoard, {0.f, 0.f});
+    mBakedBoard.display();
+
+    mBakedBoardSprite.setTexture(mBakedBoard.getTexture(), true);
+    mBakedBoardSprite.setPosition(mBoardStart);
+    return true;
   }
 
   /**
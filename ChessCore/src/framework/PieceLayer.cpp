@@ -0,0 +1,178 @@
+/**
+ * @file PieceLayer.cpp
+ * @brief Atlas packing and vertex array construction for the piece layer.
+ */
+
+#include"framework/PieceLayer.h"
+#include"framework/AssetManager.h"
+#include"framework/ChessState.h"
+#include"framework/Bitboard.h"
+#include"framework/Stage.h"
+#include<algorithm>
+#include<cmath>
+
+namespace chess
+{
+  namespace
+  {
+    /** @brief Atlas columns, in `PieceType` order (pawn, bishop, knight, rook, queen, king). */
+    constexpr int PIECE_KINDS = 6;
+
+    /** @brief Image of each white piece, in atlas column order; the black ones follow. */
+    const char* const PIECE_TEXTURES[2][PIECE_KINDS] = {
+      {
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_pawn_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_bishop_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_knight_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_rook_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_queen_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/w_king_png_shadow_1024px.png"
+      },
+      {
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_pawn_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_bishop_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_knight_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_rook_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_queen_png_shadow_1024px.png",
+        "JohnPablok Cburnett Chess set/PNGs/With Shadow/1024px/b_king_png_shadow_1024px.png"
+      }
+    };
+
+    /** @brief Horizontal nudge per column, matching `Pawn` and `Queen::SetPieceLocation`. */
+    constexpr float PIECE_NUDGE_X[PIECE_KINDS] = {6.f, 0.f, 0.f, 0.f, -6.f, 0.f};
+
+    /** @brief Drawing order: kings first, pawns last, as the per-piece renderer did. */
+    constexpr int DRAW_ORDER[PIECE_KINDS] = {6, 5, 4, 2, 3, 1};
+  }
+
+  /**
+   * @brief Pack the atlas and start with an empty vertex array.
+   */
+  PieceLayer::PieceLayer(Stage *owningStage)
+    :mAtlas{},
+    mCellSize{0.f,0.f},
+    mVertices{sf::PrimitiveType::Triangles},
+    mValid{false},
+    mBuilt{false},
+    mPositionHash{0},
+    mFlipped{false},
+    mHiddenSquare{NO_SQUARE}
+  {
+    mValid = BuildAtlas(*owningStage);
+  }
+
+  /**
+   * @brief Compare against the state the vertices were built from.
+   */
+  bool PieceLayer::IsCurrent(uint64_t positionHash, bool flipped, int hiddenSquare) const
+  {
+    return mBuilt && mPositionHash == positionHash && mFlipped == flipped && mHiddenSquare == hiddenSquare;
+  }
+
+  /**
+   * @brief Walk the piece bitboards directly; no coordinate lists are allocated.
+   */
+  void PieceLayer::Rebuild(uint64_t positionHash, bool flipped, int hiddenSquare, const std::function<sf::Vector2f(int)> &squareToPosition)
+  {
+    mVertices.clear();
+    for(bool white : {true, false})
+    {
+      for(int kind : DRAW_ORDER)
+      {
+        PieceType piece = static_cast<PieceType>(white ? kind : -kind);
+        uint64_t pieces = ChessState::Get().GetPieceBitboard(piece);
+        while(pieces)
+        {
+          int square = PopLowestSquare(pieces);
+          if(square != hiddenSquare)
+            AppendQuad(piece, squareToPosition(square) + sf::Vector2f{PIECE_NUDGE_X[kind - 1], 0.f});
+        }
+      }
+    }
+
+    mBuilt = true;
+    mPositionHash = positionHash;
+    mFlipped = flipped;
+    mHiddenSquare = hiddenSquare;
+  }
+
+  /**
+   * @brief One draw call, bound to the atlas texture.
+   */
+  void PieceLayer::Draw(sf::RenderTarget &target) const
+  {
+    target.draw(mVertices, sf::RenderStates{&mAtlas.getTexture()});
+  }
+
+  /**
+   * @brief Draw each piece texture, scaled to its on-screen size, into a 6x2 grid.
+   *
+   * The textures are the ones the piece sprites use (same size and
+   * mipmaps, so they come from the cache), scaled like those sprites. The
+   * images differ slightly in width, so a cell fits the largest; a quad
+   * then maps its cell 1:1.
+   */
+  bool PieceLayer::BuildAtlas(Stage &owningStage)
+  {
+    shared<sf::Texture> textures[2][PIECE_KINDS];
+    mCellSize = {0.f, 0.f};
+    for(int color = 0; color < 2; color++)
+    {
+      for(int kind = 0; kind < PIECE_KINDS; kind++)
+      {
+        textures[color][kind] = AssetManager::Get().LoadTexture(PIECE_TEXTURES[color][kind], owningStage.GetPieceSize(), true);
+        if(!textures[color][kind])
+          return false;
+
+        sf::Vector2f scale = owningStage.GetPieceScale(*textures[color][kind]);
+        sf::Vector2u size = textures[color][kind]->getSize();
+        mCellSize.x = std::max(mCellSize.x, std::ceil(size.x * scale.x));
+        mCellSize.y = std::max(mCellSize.y, std::ceil(size.y * scale.y));
+      }
+    }
+
+    sf::Vector2u atlasSize{static_cast<unsigned int>(mCellSize.x) * PIECE_KINDS, static_cast<unsigned int>(mCellSize.y) * 2};
+    if(!mAtlas.resize(atlasSize))
+      return false;
+
+    mAtlas.clear(sf::Color::Transparent);
+    for(int color = 0; color < 2; color++)
+    {
+      for(int kind = 0; kind < PIECE_KINDS; kind++)
+      {
+        sf::Sprite sprite{*textures[color][kind]};
+        sprite.setScale(owningStage.GetPieceScale(*textures[color][kind]));
+        sprite.setPosition({kind * mCellSize.x, color * mCellSize.y});
+        mAtlas.draw(sprite);
+      }
+    }
+    mAtlas.display();
+    return true;
+  }
+
+  /**
+   * @brief Two triangles covering the piece's atlas cell, placed at `position`.
+   */
+  void PieceLayer::AppendQuad(PieceType piece, const sf::Vector2f &position)
+  {
+    int kind = std::abs(static_cast<int>(piece));
+    sf::Vector2f cell{(kind - 1) * mCellSize.x, (static_cast<int>(piece) > 0 ? 0.f : mCellSize.y)};
+
+    sf::Vector2f topLeft = position;
+    sf::Vector2f topRight = position + sf::Vector2f{mCellSize.x, 0.f};
+    sf::Vector2f bottomLeft = position + sf::Vector2f{0.f, mCellSize.y};
+    sf::Vector2f bottomRight = position + mCellSize;
+
+    sf::Vector2f texTopLeft = cell;
+    sf::Vector2f texTopRight = cell + sf::Vector2f{mCellSize.x, 0.f};
+    sf::Vector2f texBottomLeft = cell + sf::Vector2f{0.f, mCellSize.y};
+    sf::Vector2f texBottomRight = cell + mCellSize;
+
+    mVertices.append({topLeft, sf::Color::White, texTopLeft});
+    mVertices.append({topRight, sf::Color::White, texTopRight});
+    mVertices.append({bottomLeft, sf::Color::White, texBottomLeft});
+    mVertices.append({bottomLeft, sf::Color::White, texBottomLeft});
+    mVertices.append({topRight, sf::Color::White, texTopRight});
+    mVertices.append({bottomRight, sf::Color::White, texBottomRight});
+  }
+}
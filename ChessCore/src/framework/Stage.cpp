@@ -6,6 +6,8 @@
 #include"framework/Board.h"
 #include"framework/Application.h"
 #include"framework/ChessState.h"
+#include"framework/Bitboard.h"
+#include"framework/PieceLayer.h"
 #include"Pieces/King.h"
 #include"Pieces/Queen.h"
 #include"Pieces/Rook.h"
@@ -16,6 +18,12 @@
 
 namespace chess
 {
+  namespace
+  {
+    /** @brief Piece height as a fraction of the square height. */
+    constexpr float PIECE_SQUARE_FILL = 0.9f;
+  }
+
   /**
    * @brief Construct a new Stage and initialize core subsystems.
    *
@@ -37,13 +45,14 @@ namespace chess
     mBlackKnight{},
     mBlackBishop{},
     mBlackPawn{},
+    mPieceLayer{},
     mPieceMoved{true},
+    mNeedsRedraw{true},
     mPieceOffsetX{10},
     mPieceOffsetY{8},
     mPieceSelected{false},
     mStartPose{-1,-1},
     mEndPose{-1,-1},
-    mWhiteTurn{true},
     mMouseDragging{false},
     mMousePosition{-1,-1},
     mFlipBoard{false},
@@ -54,6 +63,7 @@ namespace chess
     mCurrentEvaluation{0.0}
   {
     SpawnBoard({100.f,100.f},{800.f,800.f});
+    mPieceLayer = std::make_shared<PieceLayer>(this);
     ChessState::Get().ResetToStartPosition();
 
     mWhiteKing = SpawnPiece<King>(true);
@@ -98,11 +108,32 @@ namespace chess
     {
       mHUD->NativeInit(mOwningApp->GetWindow());
     }
-    // Update current evaluation of the board
-    CalculateCurrentEvaluation();
+    if(mHUD)
+    {
+      mHUD->Tick(deltaTime);
+    }
 
-    mHUD->Tick(deltaTime);
+    Tick(deltaTime);
   }
+  /**
+   * @brief Both flags are cleared, so one frame answers every request made before it.
+   */
+  bool Stage::ConsumeInvalidation()
+  {
+    bool widgetsChanged = Widget::ConsumeInvalidation();
+    bool redraw = mNeedsRedraw || widgetsChanged;
+    mNeedsRedraw = false;
+    return redraw;
+  }
+
+  /**
+   * @brief Nothing runs in the background by default.
+   */
+  bool Stage::NeedsTick() const
+  {
+    return false;
+  }
+
   /**
    * @brief Convenience to access the application window.
    */
@@ -160,12 +191,53 @@ namespace chess
 
   /**
    * @brief Render all pieces, possible moves, and drag visuals.
+   *
+   * Pieces on the board come from the batched `PieceLayer`, rebuilt only
+   * when the position, the orientation or the dragged piece changed.
    */
   void Stage::RenderPieces()
   {
     // Render red if king in check
     RenderKingInCheck();
 
+    // If piece is picked and mouse is dragging it is drawn at the mouse instead
+    int hiddenSquare = mPieceSelected && mMouseDragging && mStartPose.isValid() ? ToSquare(mStartPose) : NO_SQUARE;
+    if(mPieceLayer->IsValid())
+    {
+      uint64_t hash = ChessState::Get().GetHash();
+      if(!mPieceLayer->IsCurrent(hash, mFlipBoard, hiddenSquare))
+      {
+        mPieceLayer->Rebuild(hash, mFlipBoard, hiddenSquare, [this](int square){ return ConvertChessCoordinateToPosition(ToChessCoordinate(square)); });
+      }
+      mPieceLayer->Draw(mOwningApp->GetWindow());
+    }
+    else
+    {
+      RenderPiecesIndividually();
+    }
+
+    // Render Possible moves if piece Selected
+    if(mRenderPossibleMoves && mPieceSelected)
+    {
+      RenderPossibleMoves();
+    }
+
+    if(mMouseDragging && mPieceSelected && mStartPose.isValid())
+    {
+      PieceType piece = ChessState::Get().GetPieceOnChessCoordinate(mStartPose);
+      if(piece != PieceType::invalid)
+      {
+        GetPieceContainer(piece)->SetPieceLocation({float(mMousePosition.x - mBoard->GetSquareOffsetX()/2.f) ,float(mMousePosition.y - mBoard->GetSquareOffsetY()/2.f)},GetPieceContainer(piece)->GetPieceColor());
+        GetPieceContainer(piece)->RenderPiece();
+      }
+    }
+  }
+
+  /**
+   * @brief Draw every piece with its own sprite; used when the piece atlas is unavailable.
+   */
+  void Stage::RenderPiecesIndividually()
+  {
     PieceType whitePieces[6] = {PieceType::whiteKing, PieceType::whiteQueen, PieceType::whiteRook, PieceType::whiteBishop, PieceType::whiteKnight, PieceType::whitePawn};
     PieceType blackPieces[6] = {PieceType::blackKing, PieceType::blackQueen, PieceType::blackRook, PieceType::blackBishop, PieceType::blackKnight, PieceType::blackPawn};
 
@@ -176,7 +248,7 @@ namespace chess
       for(auto &coordinate : coordinates)
       {
         // If piece is picked and mouse is dragging dont render
-        if(mWhiteTurn && mPieceSelected && mMouseDragging && mStartPose.isValid() && coordinate == mStartPose)
+        if(IsWhiteTurn() && mPieceSelected && mMouseDragging && mStartPose.isValid() && coordinate == mStartPose)
           continue;
         else
         {
@@ -193,7 +265,7 @@ namespace chess
       for(auto &coordinate : coordinates)
       {
         // If piece is picked and mouse is dragging dont render
-        if(!mWhiteTurn && mPieceSelected && mMouseDragging && mStartPose.isValid() && coordinate == mStartPose)
+        if(!IsWhiteTurn() && mPieceSelected && mMouseDragging && mStartPose.isValid() && coordinate == mStartPose)
           continue;
         else
         {
@@ -202,22 +274,6 @@ namespace chess
         }
       }
     }
-
-    // Render Possible moves if piece Selected
-    if(mRenderPossibleMoves && mPieceSelected)
-    {
-      RenderPossibleMoves();
-    }
-
-    if(mMouseDragging && mPieceSelected && mStartPose.isValid())
-    {
-      PieceType piece = ChessState::Get().GetPieceOnChessCoordinate(mStartPose);
-      if(piece != PieceType::invalid)
-      {
-        GetPieceContainer(piece)->SetPieceLocation({float(mMousePosition.x - mBoard->GetSquareOffsetX()/2.f) ,float(mMousePosition.y - mBoard->GetSquareOffsetY()/2.f)},GetPieceContainer(piece)->GetPieceColor());
-        GetPieceContainer(piece)->RenderPiece();
-      }
-    }
   }
 
   /**
@@ -225,8 +281,8 @@ namespace chess
    */
   bool Stage::CheckCorrectPieceSelected(PieceType piece)
   {
-      if((mWhiteTurn && static_cast<int>(piece) > 0) 
-          || (!mWhiteTurn && static_cast<int>(piece) < 0))
+      if((IsWhiteTurn() && static_cast<int>(piece) > 0) 
+          || (!IsWhiteTurn() && static_cast<int>(piece) < 0))
           return true;
       return false;
   }
@@ -246,37 +302,34 @@ namespace chess
     {
       if(mEndPose.file - mStartPose.file > 0)
       {
-        CastleKingSide(mWhiteTurn);
+        CastleKingSide(IsWhiteTurn());
       }
       else if(mEndPose.file - mStartPose.file < 0)
       {
-        CastleQueenSide(mWhiteTurn);
+        CastleQueenSide(IsWhiteTurn());
       }
-      mWhiteTurn = !mWhiteTurn;
       return true;
     }
 
     // Determine whose turn and valid move
-    if((mWhiteTurn && piecePointer->GetPieceColor() && piecePointer->MovePossible(mStartPose,mEndPose)) || 
-      (!mWhiteTurn && !piecePointer->GetPieceColor() && piecePointer->MovePossible(mStartPose,mEndPose)))
+    if(IsWhiteTurn() == piecePointer->GetPieceColor())
     {
-      piecePointer->MakeMove(mStartPose, mEndPose);
-      bool kingInCheck = mWhiteTurn ? mWhiteKing->IsInCheck() : mBlackKing->IsInCheck();
-      
-      if(kingInCheck)// If King in Check after making move then illegal move
-      {
-        ChessState::Get().UndoLastMove();
+      const Position& position = ChessState::Get().GetPosition();
+      bool promotion = (piece == PieceType::whitePawn && mEndPose.rank == 8) || (piece == PieceType::blackPawn && mEndPose.rank == 1);
+
+      // Only moves from the legal move list may be played
+      if(!mEndPose.isValid() || !ChessState::Get().IsLegalMove(position.BuildMove(ToSquare(mStartPose), ToSquare(mEndPose))))
         return false;
-      }
       
       // Check for promotion
-      ChessCoordinate pawnToPromote = mWhiteTurn ? mWhitePawn->PawnToPromote() : mBlackPawn->PawnToPromote();
-      if(pawnToPromote.isValid())
+      if(promotion)
+      {
+        ChessState::Get().SetPiecePosition(piece, mStartPose, mEndPose, WhichPieceToPromote());
+      }
+      else
       {
-        ChessState::Get().RemovePiece(mWhiteTurn ? PieceType::whitePawn : PieceType::blackPawn, pawnToPromote);
-        ChessState::Get().SpawnPiece(WhichPieceToPromote(), pawnToPromote);
+        piecePointer->MakeMove(mStartPose, mEndPose);
       }
-      mWhiteTurn = !mWhiteTurn;
       return true;
     }  
     return false;
@@ -290,55 +343,56 @@ namespace chess
       if(kingCoordinate == rookCoordinate)return false;
 
       int offsetFile = (rookCoordinate.file - kingCoordinate.file) > 0 ? 1 :  -1;
-      ChessCoordinate rookEndCoordinate{mWhiteTurn ? 1 : 8 ,offsetFile > 0 ? 'h' : 'a'};
+      const Position& position = ChessState::Get().GetPosition();
 
-      if(mWhiteTurn)
+      // Castling rights are lost as soon as the king or the rook moves
+      if(IsWhiteTurn())
       {
         if(ChessState::Get().GetPieceOnChessCoordinate(kingCoordinate) != PieceType::whiteKing 
+          || rookCoordinate.rank != 1
           || abs(rookCoordinate.file - kingCoordinate.file) < 2
-          || !ChessState::Get().IsFirstMove(ChessState::Get().GetPiecePosiiton(PieceType::whiteKing)[0])
-          || (offsetFile == 1 && !ChessState::Get().IsFirstMove(ChessCoordinate{1,'h'}))
-          || (offsetFile == -1 && !ChessState::Get().IsFirstMove(ChessCoordinate{1,'a'}))
+          || !position.HasCastlingRight(offsetFile == 1 ? CASTLE_WHITE_KING_SIDE : CASTLE_WHITE_QUEEN_SIDE)
           || mWhiteKing->IsInCheck())
             return false;
-        
-        Set<ChessCoordinate,ChessCoordinateHashFunction> blackAttackedSquares = ChessState::Get().GetBlackAttackedSquares();
-        ChessCoordinate iter{kingCoordinate.rank,kingCoordinate.file};
-        iter.file += offsetFile;
 
-        while(iter.isValid() && !(iter == rookEndCoordinate))
-        {
-          if(ChessState::Get().GetPieceOnChessCoordinate(iter) != PieceType::invalid || blackAttackedSquares.find(iter) != blackAttackedSquares.end())
-            return false;
-          iter.file += offsetFile;
-        }
-        return true;
+        return !(ChessState::Get().GetOccupancy() & CastlingEmptyMask(1, offsetFile > 0))
+          && !(ChessState::Get().GetBlackAttacks() & CastlingKingPathMask(1, offsetFile > 0));
       }
       else
       {
         if(ChessState::Get().GetPieceOnChessCoordinate(kingCoordinate) != PieceType::blackKing 
+          || rookCoordinate.rank != 8
           || abs(rookCoordinate.file - kingCoordinate.file) < 2
-          || !ChessState::Get().IsFirstMove(ChessState::Get().GetPiecePosiiton(PieceType::blackKing)[0])
-          || (offsetFile == 1 && !ChessState::Get().IsFirstMove(ChessCoordinate{8,'h'}))
-          || (offsetFile == -1 && !ChessState::Get().IsFirstMove(ChessCoordinate{8,'a'}))
+          || !position.HasCastlingRight(offsetFile == 1 ? CASTLE_BLACK_KING_SIDE : CASTLE_BLACK_QUEEN_SIDE)
           || mBlackKing->IsInCheck())
             return false;
-        
-        Set<ChessCoordinate,ChessCoordinateHashFunction> whiteAttackedSquares = ChessState::Get().GetWhiteAttackedSquares();
-        ChessCoordinate iter{kingCoordinate.rank,kingCoordinate.file};
-        iter.file += offsetFile;
 
-        while(iter.isValid() && !(iter == rookEndCoordinate))
-        {
-          if(ChessState::Get().GetPieceOnChessCoordinate(iter) != PieceType::invalid || whiteAttackedSquares.find(iter) != whiteAttackedSquares.end())
-            return false;
-          iter.file += offsetFile;
-        }
-        return true;
+        return !(ChessState::Get().GetOccupancy() & CastlingEmptyMask(8, offsetFile > 0))
+          && !(ChessState::Get().GetWhiteAttacks() & CastlingKingPathMask(8, offsetFile > 0));
       }
       return false;
   }
   
+  /**
+   * @brief Squares between king and rook that must be empty to castle.
+   */
+  uint64_t Stage::CastlingEmptyMask(int backRank, bool kingSide)
+  {
+    if(kingSide)
+      return SquareBit(ToSquare(backRank,'f')) | SquareBit(ToSquare(backRank,'g'));
+    return SquareBit(ToSquare(backRank,'b')) | SquareBit(ToSquare(backRank,'c')) | SquareBit(ToSquare(backRank,'d'));
+  }
+
+  /**
+   * @brief Squares the king crosses while castling, which must not be attacked.
+   */
+  uint64_t Stage::CastlingKingPathMask(int backRank, bool kingSide)
+  {
+    if(kingSide)
+      return SquareBit(ToSquare(backRank,'f')) | SquareBit(ToSquare(backRank,'g'));
+    return SquareBit(ToSquare(backRank,'c')) | SquareBit(ToSquare(backRank,'d'));
+  }
+
   /**
    * @brief Perform king-side castling for the given side.
    */
@@ -348,21 +402,15 @@ namespace chess
       {
         ChessCoordinate kingCoordinateStart = ChessCoordinate{1,'e'};
         ChessCoordinate kingCoordinateEnd = ChessCoordinate{1,'g'};
-        ChessCoordinate rookCoordinateStart = ChessCoordinate{1,'h'};
-        ChessCoordinate rookCoordinateEnd = ChessCoordinate{1,'f'};
 
         mWhiteKing->MakeMove(kingCoordinateStart,kingCoordinateEnd);
-        ChessState::Get().SetPiecePosition(PieceType::whiteRook,rookCoordinateStart,rookCoordinateEnd,false);
       }
       else
       {
         ChessCoordinate kingCoordinateStart = ChessCoordinate{8,'e'};
         ChessCoordinate kingCoordinateEnd = ChessCoordinate{8,'g'};
-        ChessCoordinate rookCoordinateStart = ChessCoordinate{8,'h'};
-        ChessCoordinate rookCoordinateEnd = ChessCoordinate{8,'f'};
 
         mBlackKing->MakeMove(kingCoordinateStart,kingCoordinateEnd);
-        ChessState::Get().SetPiecePosition(PieceType::blackRook,rookCoordinateStart,rookCoordinateEnd,false);
       }
   }
 
@@ -375,21 +423,15 @@ namespace chess
     {
       ChessCoordinate kingCoordinateStart = ChessCoordinate{1,'e'};
       ChessCoordinate kingCoordinateEnd = ChessCoordinate{1,'c'};
-      ChessCoordinate rookCoordinateStart = ChessCoordinate{1,'a'};
-      ChessCoordinate rookCoordinateEnd = ChessCoordinate{1,'d'};
 
       mWhiteKing->MakeMove(kingCoordinateStart,kingCoordinateEnd);
-      ChessState::Get().SetPiecePosition(PieceType::whiteRook,rookCoordinateStart,rookCoordinateEnd,false);
     }
     else
     {
       ChessCoordinate kingCoordinateStart = ChessCoordinate{8,'e'};
       ChessCoordinate kingCoordinateEnd = ChessCoordinate{8,'c'};
-      ChessCoordinate rookCoordinateStart = ChessCoordinate{8,'a'};
-      ChessCoordinate rookCoordinateEnd = ChessCoordinate{8,'d'};
 
       mBlackKing->MakeMove(kingCoordinateStart,kingCoordinateEnd);
-      ChessState::Get().SetPiecePosition(PieceType::blackRook,rookCoordinateStart,rookCoordinateEnd,false);
     }
   }
 
@@ -476,7 +518,7 @@ namespace chess
   PieceType Stage::WhichPieceToPromote()
   {
       // TODO :: Implement an ask to which piece to promote
-      return mWhiteTurn ? PieceType::whiteQueen : PieceType::blackQueen;
+      return IsWhiteTurn() ? PieceType::whiteQueen : PieceType::blackQueen;
   }
 
   /**
@@ -484,115 +526,7 @@ namespace chess
    */
   GameState Stage::EndState()
   {
-      bool ongoing = false; 
-      if(mWhiteTurn)
-      {
-        bool whiteKingInCheck = mWhiteKing->IsInCheck();
-        // Check for all possible moves for white Pieces
-        // White kings moves
-        List<ChessCoordinate> startCoordinate = ChessState::Get().GetPiecePosiiton(PieceType::whiteKing);
-        List<ChessCoordinate> moves = mWhiteKing->GetAllPossibleMoves(startCoordinate[0]);
-        
-        if(moves.size() > 0)
-          ongoing = true;
-
-        PieceType whitePieces[5] = {PieceType::whitePawn, PieceType::whiteKnight, PieceType::whiteBishop, PieceType::whiteRook, PieceType::whiteQueen};
-
-        for(int p = 0; p < 5 ; p++)
-        {
-          shared<Piece> pieceContainer = GetPieceContainer(whitePieces[p]);
-          startCoordinate = ChessState::Get().GetPiecePosiiton(whitePieces[p]);
-          for(int i = 0; !ongoing && i < startCoordinate.size(); i++)
-          {
-            moves = pieceContainer->GetAllPossibleMoves(startCoordinate[i]);
-            for(int j = 0; j < moves.size(); j++ )
-            {
-              ChessState::Get().SetPiecePosition(whitePieces[p],startCoordinate[i],moves[j]);
-              if(!mWhiteKing->IsInCheck())
-                ongoing = true;
-              ChessState::Get().UndoLastMove();
-            }
-          }
-        }
-
-        // Check for draw 
-        if(ongoing)
-        {
-          //Check for 50 move rule
-          if(ChessState::Get().GetMovesWithoutCapture() >= 100 )return GameState::Draw;  
-
-          // Check if enough checkmating material available
-          if(ChessState::Get().GetPieceCount(PieceType::whiteQueen) || ChessState::Get().GetPieceCount(PieceType::blackQueen) 
-            || ChessState::Get().GetPieceCount(PieceType::whiteRook) || ChessState::Get().GetPieceCount(PieceType::blackRook)
-            || ChessState::Get().GetPieceCount(PieceType::whitePawn) || ChessState::Get().GetPieceCount(PieceType::blackPawn)
-            || ChessState::Get().GetPieceCount(PieceType::whiteBishop) == 2 || ChessState::Get().GetPieceCount(PieceType::blackBishop) == 2
-            || (ChessState::Get().GetPieceCount(PieceType::whiteBishop) && ChessState::Get().GetPieceCount(PieceType::whiteKnight))
-            || (ChessState::Get().GetPieceCount(PieceType::blackBishop) && ChessState::Get().GetPieceCount(PieceType::blackKnight)) )
-            {
-              return GameState::Ongoing;
-            }
-          return GameState::Draw;
-        }
-        else
-        {
-          return whiteKingInCheck ? GameState::BlackWon : GameState::Draw;
-        }
-      }
-      // Black's turn
-      else
-      {
-        bool blackKingInCheck = mBlackKing->IsInCheck();
-        // Check for all possible moves for black Pieces
-        // Black kings moves
-        List<ChessCoordinate> startCoordinate = ChessState::Get().GetPiecePosiiton(PieceType::blackKing);
-        List<ChessCoordinate> moves = mBlackKing->GetAllPossibleMoves(startCoordinate[0]);
-        
-        if(moves.size() > 0)
-          ongoing = true;
-
-        PieceType blackPieces[5] = {PieceType::blackPawn, PieceType::blackKnight, PieceType::blackBishop, PieceType::blackRook, PieceType::blackQueen};
-
-        for(int p = 0; p < 5 ; p++)
-        {
-          shared<Piece> pieceContainer = GetPieceContainer(blackPieces[p]);
-          startCoordinate = ChessState::Get().GetPiecePosiiton(blackPieces[p]);
-          for(int i = 0; !ongoing && i < startCoordinate.size(); i++)
-          {
-            moves = pieceContainer->GetAllPossibleMoves(startCoordinate[i]);
-            for(int j = 0; j < moves.size(); j++ )
-            {
-              ChessState::Get().SetPiecePosition(blackPieces[p],startCoordinate[i],moves[j]);
-              if(!mBlackKing->IsInCheck())
-                ongoing = true;
-              ChessState::Get().UndoLastMove();
-            }
-          }
-        }
-
-        // Check for draw 
-        if(ongoing)
-        {
-          //Check for 50 move rule
-          if(ChessState::Get().GetMovesWithoutCapture() >= 100 )return GameState::Draw;
-
-          // Check if enough checkmating material available
-          if(ChessState::Get().GetPieceCount(PieceType::whiteQueen) || ChessState::Get().GetPieceCount(PieceType::blackQueen)
-            || ChessState::Get().GetPieceCount(PieceType::whiteRook) || ChessState::Get().GetPieceCount(PieceType::blackRook)
-            || ChessState::Get().GetPieceCount(PieceType::whitePawn) || ChessState::Get().GetPieceCount(PieceType::blackPawn)
-            || ChessState::Get().GetPieceCount(PieceType::whiteBishop) == 2 || ChessState::Get().GetPieceCount(PieceType::blackBishop) == 2
-            || (ChessState::Get().GetPieceCount(PieceType::whiteBishop) && ChessState::Get().GetPieceCount(PieceType::whiteKnight))
-            || (ChessState::Get().GetPieceCount(PieceType::blackBishop) && ChessState::Get().GetPieceCount(PieceType::blackKnight)) )
-            {
-              return GameState::Ongoing;
-            }
-          return GameState::Draw;
-        }
-        else
-        {
-          return blackKingInCheck ? GameState::WhiteWon : GameState::Draw;
-        }
-      }
-    return GameState::Draw;
+    return ChessState::Get().GetGameState();
   }
 
   /**
@@ -605,31 +539,31 @@ namespace chess
 
     sf::CircleShape circle{mBoard->GetSquareOffsetY()/6.f};
 
-    shared<Piece> piecePointer = GetPieceContainer(piece);
-    for(auto move : piecePointer->GetAllPossibleMoves(mStartPose))
+    int startSquare = ToSquare(mStartPose);
+    for(Move possibleMove : ChessState::Get().GetLegalMoves())
     {
-      ChessState::Get().SetPiecePosition(piece,mStartPose,move);
-      bool kingInCheck = ChessState::Get().KingInCheck(mWhiteTurn);
-      ChessState::Get().UndoLastMove();
-      if(!kingInCheck)
+      // One marker per target square is enough for promotions
+      if(possibleMove.GetFrom() != startSquare
+        || (possibleMove.GetFlag() == MoveFlag::Promotion && possibleMove.GetPromotion(true) != PieceType::whiteQueen))
+        continue;
+
+      ChessCoordinate move = ToChessCoordinate(possibleMove.GetTo());
+      if(ChessState::Get().GetPieceOnChessCoordinate(move) == PieceType::invalid)
       {
-        if(ChessState::Get().GetPieceOnChessCoordinate(move) == PieceType::invalid)
-        {
-          circle.setRadius(mBoard->GetSquareOffsetY()/6.f);
-          circle.setOutlineThickness(0.f);
-          circle.setPosition(sf::Vector2f{mBoard->GetSquareOffsetX()/4.f , mBoard->GetSquareOffsetY()/4.f} + ConvertChessCoordinateToPosition(move));
-          circle.setFillColor(mPossibleMovesColor);
-        }
-        else//If move is a capture
-        {
-          circle.setRadius(mBoard->GetSquareOffsetY()/2.6f);
-          circle.setOutlineColor(mPossibleMovesColor);
-          circle.setOutlineThickness(10.f);
-          circle.setFillColor(sf::Color{0,0,0,0});
-          circle.setPosition(ConvertChessCoordinateToPosition(move));
-        }
-        mOwningApp->GetWindow().draw(circle);
+        circle.setRadius(mBoard->GetSquareOffsetY()/6.f);
+        circle.setOutlineThickness(0.f);
+        circle.setPosition(sf::Vector2f{mBoard->GetSquareOffsetX()/4.f , mBoard->GetSquareOffsetY()/4.f} + ConvertChessCoordinateToPosition(move));
+        circle.setFillColor(mPossibleMovesColor);
       }
+      else//If move is a capture
+      {
+        circle.setRadius(mBoard->GetSquareOffsetY()/2.6f);
+        circle.setOutlineColor(mPossibleMovesColor);
+        circle.setOutlineThickness(10.f);
+        circle.setFillColor(sf::Color{0,0,0,0});
+        circle.setPosition(ConvertChessCoordinateToPosition(move));
+      }
+      mOwningApp->GetWindow().draw(circle);
     }
   }
 
@@ -638,11 +572,11 @@ namespace chess
    */
   void Stage::RenderKingInCheck()
   {
-    if(ChessState::Get().KingInCheck(mWhiteTurn))
+    if(ChessState::Get().KingInCheck(IsWhiteTurn()))
     {
       sf::RectangleShape rect{sf::Vector2f{mBoard->GetSquareOffsetX(),mBoard->GetSquareOffsetY()}};
       rect.setFillColor(mKingInCheckColor);
-      rect.setPosition(ConvertChessCoordinateToPosition(mWhiteTurn ? ChessState::Get().GetPiecePosiiton(PieceType::whiteKing)[0] : ChessState::Get().GetPiecePosiiton(PieceType::blackKing)[0] ) + sf::Vector2f{-10.f,-10.f});
+      rect.setPosition(ConvertChessCoordinateToPosition(IsWhiteTurn() ? ChessState::Get().GetPiecePosiiton(PieceType::whiteKing)[0] : ChessState::Get().GetPiecePosiiton(PieceType::blackKing)[0] ) + sf::Vector2f{-10.f,-10.f});
       mOwningApp->GetWindow().draw(rect);
     }
     
@@ -653,16 +587,16 @@ namespace chess
    */
   void Stage::RenderLastPlayedMove()
   {
-    List<ChessCoordinate> lastMove = ChessState::Get().GetLastPlayedMove();
-    if(lastMove.size() < 2) return;
+    Move lastMove = ChessState::Get().GetLastPlayedMove();
+    if(!lastMove.IsValid()) return;
 
     sf::RectangleShape rect{{mBoard->GetSquareOffsetX(),mBoard->GetSquareOffsetY()}};
     rect.setFillColor({255,255,255,20});
     
-    rect.setPosition(ConvertChessCoordinateToPosition(lastMove[0]) - sf::Vector2f{10.f,8.f});
+    rect.setPosition(ConvertChessCoordinateToPosition(ToChessCoordinate(lastMove.GetFrom())) - sf::Vector2f{10.f,8.f});
     mOwningApp->GetWindow().draw(rect);
 
-    rect.setPosition(ConvertChessCoordinateToPosition(lastMove[1]) - sf::Vector2f{10.f,8.f});
+    rect.setPosition(ConvertChessCoordinateToPosition(ToChessCoordinate(lastMove.GetTo())) - sf::Vector2f{10.f,8.f});
     mOwningApp->GetWindow().draw(rect);
   }
 
@@ -713,9 +647,13 @@ namespace chess
       if(const auto* mouseMoved = event->getIf<sf::Event::MouseMoved>())
       {
         mMousePosition = mouseMoved->position;
+        // Only a dragged piece follows the mouse
+        if(mMouseDragging && mPieceSelected)
+          Invalidate();
       }
       if (const auto* mouseButtonPressed = event->getIf<sf::Event::MouseButtonPressed>())
       {
+          Invalidate();
           if (mouseButtonPressed->button == sf::Mouse::Button::Left)
           {      
               mMouseDragging = true;     
@@ -733,6 +671,7 @@ namespace chess
                 if(MovePiece(piece))
                 {
                   SetPieceMoved(true);
+                  CalculateCurrentEvaluation();
                 }
                 mPieceSelected = false;
                 handled = true;
@@ -746,12 +685,14 @@ namespace chess
       }
       else if( const auto* mouseButtonReleased = event->getIf<sf::Event::MouseButtonReleased>())
       {
+        Invalidate();
         mMouseDragging = false;
         mEndPose = ConvertPositionToChessCoordinate({mouseButtonReleased->position.x,mouseButtonReleased->position.y});
         PieceType piece = ChessState::Get().GetPieceOnChessCoordinate(mStartPose);
         if(MovePiece(piece))
         {
           SetPieceMoved(true);
+          CalculateCurrentEvaluation();
           mPieceSelected = false;
         }
 
@@ -759,10 +700,11 @@ namespace chess
       }
       else if (const auto* keyPress = event->getIf<sf::Event::KeyPressed>())
       {
+        Invalidate();
         if(keyPress->scancode == sf::Keyboard::Scan::Left && ChessState::Get().UndoLastMove())
         {
           SetPieceMoved(true);
-          mWhiteTurn = !mWhiteTurn;
+          CalculateCurrentEvaluation();
         }
         else if(keyPress->scancode == sf::Keyboard::Scan::F)
         {
@@ -782,6 +724,44 @@ namespace chess
 
   }
 
+  /**
+   * @brief Nothing to do per tick by default.
+   */
+  void Stage::Tick(float deltaTime)
+  {
+
+  }
+
+  /**
+   * @brief Read from the game position, so undo, FEN setup and engine moves all agree.
+   */
+  bool Stage::IsWhiteTurn() const
+  {
+    return ChessState::Get().GetPosition().IsWhiteToMove();
+  }
+
+  /**
+   * @brief Apply a legal move to `ChessState` and hand the turn over.
+   *
+   * Goes through the same `ChessState::SetPiecePosition` path as a dragged
+   * piece, so castling, en passant and promotion are handled identically.
+   */
+  bool Stage::PlayMove(Move move)
+  {
+    if(!ChessState::Get().IsLegalMove(move)) return false;
+
+    ChessCoordinate start = ToChessCoordinate(move.GetFrom());
+    ChessCoordinate end = ToChessCoordinate(move.GetTo());
+    PieceType promotion = move.GetFlag() == MoveFlag::Promotion ? move.GetPromotion(IsWhiteTurn()) : PieceType::invalid;
+    ChessState::Get().SetPiecePosition(ChessState::Get().GetPieceOnChessCoordinate(start), start, end, promotion);
+
+    mPieceSelected = false;
+    SetPieceMoved(true);
+    Invalidate();
+    CalculateCurrentEvaluation();
+    return true;
+  }
+
   /**
    * @brief Returns the current evaluation of the current Position.
    */
@@ -793,18 +773,13 @@ namespace chess
   /**
    * @brief Calculates the current evaluation of the current Position.
    *
-   * Currently doing the evaluation based on the pieces remaining on the board for both sides
-   * TODO :: Add stockfish for correct evaluation of the current position
+   * Reads the material and piece-square score `ChessState` keeps up to date
+   * as moves are made, in pawns. Called only when the position changes;
+   * the analysis board refines it with a search or an external UCI engine.
    */
   void Stage::CalculateCurrentEvaluation()
   {
-      int whitePoints = (ChessState::Get().GetPieceCount(PieceType::whitePawn) + 3 * ChessState::Get().GetPieceCount(PieceType::whiteBishop) 
-              + 3 * ChessState::Get().GetPieceCount(PieceType::whiteKnight) + 5 * ChessState::Get().GetPieceCount(PieceType::whiteRook)
-            + 9 * ChessState::Get().GetPieceCount(PieceType::whiteQueen));
-      int blackPoints = (ChessState::Get().GetPieceCount(PieceType::blackPawn) + 3 * ChessState::Get().GetPieceCount(PieceType::blackBishop) 
-              + 3 * ChessState::Get().GetPieceCount(PieceType::blackKnight) + 5 * ChessState::Get().GetPieceCount(PieceType::blackRook)
-            + 9 * ChessState::Get().GetPieceCount(PieceType::blackQueen));
-      float currEval = whitePoints - blackPoints;
+      float currEval = ChessState::Get().GetEvaluation() / 100.f;
 
       // Update evaluation if changed
       if(currEval != mCurrentEvaluation)
@@ -821,4 +796,21 @@ namespace chess
   {
       return mBoard->GetSpriteScale();
   }
+
+  /**
+   * @brief A piece fills most of its square, leaving room for the square's shadow.
+   */
+  unsigned int Stage::GetPieceSize()
+  {
+      return static_cast<unsigned int>(mBoard->GetSquareOffsetY() * PIECE_SQUARE_FILL);
+  }
+
+  /**
+   * @brief Uniform scale from the texture height, so every resolution ends up the same size.
+   */
+  sf::Vector2f Stage::GetPieceScale(const sf::Texture &texture)
+  {
+      float scale = static_cast<float>(GetPieceSize()) / static_cast<float>(texture.getSize().y);
+      return {scale, scale};
+  }
 }
\ No newline at end of file
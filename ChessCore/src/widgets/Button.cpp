@@ -40,6 +40,7 @@ namespace chess
     {
         mButtonText.setString(newString);
         CenterText();
+        Invalidate();
     }
 
     /**
@@ -58,6 +59,7 @@ namespace chess
     {
         mButtonColor = newButtonColor;
         mButtonSprite.setColor(mButtonColor.buttonDefaultColor);
+        Invalidate();
     }
     
     /**
@@ -68,6 +70,7 @@ namespace chess
         mButtonTextSize = textSize;
         mButtonText.setCharacterSize(textSize);
         CenterText();
+        Invalidate();
     }
 
     /**
@@ -172,14 +175,20 @@ namespace chess
     
     /**
      * @brief Set visual state to "up" (not pressed) and apply default color.
+     *
+     * Called for every mouse move outside the button, so it only requests a
+     * redraw when the button was actually hovered or pressed.
      */
     void Button::ButtonUp()
     {
         mIsButtonDown = false;
+        if(mButtonSprite.getColor() == mButtonColor.buttonDefaultColor)
+            return;
         mButtonSprite.setColor(mButtonColor.buttonDefaultColor);
         mButtonText.setCharacterSize(mButtonTextSize);
         mButtonText.setFillColor(sf::Color::White);
         CenterText();
+        Invalidate();
     }
     
     /**
@@ -189,6 +198,7 @@ namespace chess
     {
         mIsButtonDown = true;
         mButtonSprite.setColor(mButtonColor.buttonDownColor);
+        Invalidate();
     }
     
     /**
@@ -196,9 +206,12 @@ namespace chess
      */
     void Button::MouseHovered()
     {
+        if(mButtonSprite.getColor() == mButtonColor.buttonHoverColor)
+            return;
         mButtonSprite.setColor(mButtonColor.buttonHoverColor);
         mButtonText.setCharacterSize(mButtonTextSize + 3);
         mButtonText.setFillColor(sf::Color::Black);
         CenterText();
+        Invalidate();
     }
 }
@@ -61,6 +61,7 @@ namespace chess
         // Adding offset from the main background widget for Positive bar
         sf::FloatRect mBackgroundBar = mBackground.getGlobalBounds();
         mPositiveBar.setPosition({mBackgroundBar.position.x, mBackgroundBar.position.y + negativeFillHeight});
+        Invalidate();
     }
 
     /**
@@ -25,6 +25,7 @@ namespace chess
     void ImageWidget::SetScale(sf::Vector2f newScale)
     {
         mImageSprite.setScale(newScale);
+        Invalidate();
     }
 
     /**
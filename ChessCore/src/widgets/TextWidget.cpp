@@ -26,6 +26,7 @@ namespace chess
     void TextWidget::SetTextSize(unsigned int textSize)
     {
         mText.setCharacterSize(textSize);
+        Invalidate();
     }
 
     /**
@@ -33,7 +34,10 @@ namespace chess
      */
     void TextWidget::SetTextString(const std::string &newStr)
     {
+        if(mText.getString() == newStr)
+            return;
         mText.setString(newStr);
+        Invalidate();
     }
 
     /**
@@ -6,6 +6,8 @@
 
 namespace chess
 {
+    bool Widget::sInvalidated = true;
+
     /**
      * @brief Internal draw wrapper that respects visibility.
      * Calls `Draw()` only if `mIsVisible` is true.
@@ -34,6 +36,7 @@ namespace chess
     {
         mWidgetTransform.setPosition(newLocation);
         LocationUpdated(newLocation);
+        Invalidate();
     }
 
     /**
@@ -43,6 +46,18 @@ namespace chess
     {
         mWidgetTransform.setRotation(newRotation);
         RotationUpdated(newRotation);
+        Invalidate();
+    }
+
+    /**
+     * @brief Show or hide the widget; only an actual change needs a redraw.
+     */
+    void Widget::SetVisibility(bool newVisibility)
+    {
+        if(mIsVisible == newVisibility)
+            return;
+        mIsVisible = newVisibility;
+        Invalidate();
     }
 
     /**
@@ -55,6 +70,16 @@ namespace chess
         return sf::Vector2f(bound.position.x + bound.size.x / 2.f , bound.position.y + bound.size.y / 2.f);
     }
 
+    /**
+     * @brief Read and clear the shared redraw request.
+     */
+    bool Widget::ConsumeInvalidation()
+    {
+        bool invalidated = sInvalidated;
+        sInvalidated = false;
+        return invalidated;
+    }
+
     /**
      * @brief Construct a visible widget with default transform.
      */
@@ -0,0 +1,75 @@
+/**
+ * @file AnalysisWorker.h
+ * @brief Continuous background analysis of the position on the board.
+ */
+#pragma once
+
+#include"engine/SearchThread.h"
+#include"engine/SpscQueue.h"
+
+namespace chess
+{
+    /**
+     * @brief One completed iteration of the analysis.
+     *
+     * Trivially copyable so it can travel through `SpscQueue` without
+     * allocating on either thread.
+     */
+    struct AnalysisUpdate
+    {
+        uint32_t mGeneration = 0;           ///< Analysis the update belongs to
+        int mDepth = 0;                     ///< Completed depth
+        int mScore = 0;                     ///< Centipawns from white's point of view (or mate score)
+        uint64_t mNodes = 0;                ///< Nodes searched so far
+        int mVariationLength = 0;           ///< Number of moves in `mVariation`
+        Move mVariation[MAX_PLY] = {};      ///< Principal variation
+
+        /** @brief True if `mScore` announces mate. */
+        bool IsMate() const { return mScore >= MATE_BOUND || mScore <= -MATE_BOUND; }
+
+        /** @brief Moves until mate (positive when white mates), only meaningful if `IsMate()`. */
+        int GetMateInMoves() const { return mScore > 0 ? (MATE_SCORE - mScore + 1) / 2 : -(MATE_SCORE + mScore + 1) / 2; }
+    };
+
+    /**
+     * @brief Runs an infinite search on a worker thread and streams its iterations.
+     *
+     * `Analyse` restarts the search on a new position. Every completed
+     * iteration is pushed onto a single-producer/single-consumer queue that
+     * the game thread drains with `PollUpdate`, so the game thread never
+     * blocks on the search. Updates of a previous position still queued when
+     * the position changes are discarded.
+     */
+    class AnalysisWorker
+    {
+        public:
+            AnalysisWorker();
+
+            /**
+             * @brief Start analysing a position, abandoning the previous analysis.
+             * @param position Position to analyse
+             * @param history Keys of the game positions before it
+             */
+            void Analyse(const Position& position, const List<uint64_t>& history = {});
+
+            /** @brief Stop analysing. */
+            void Stop();
+
+            /**
+             * @brief Take the next update of the current analysis (game thread).
+             * @return False if no new update is available
+             */
+            bool PollUpdate(AnalysisUpdate& update);
+
+        private:
+            /** @brief Iteration callback, runs on the worker thread. */
+            void PushIteration(const SearchResult& result);
+
+            static constexpr size_t QUEUE_CAPACITY = 64;
+
+            SearchThread mSearchThread;                             ///< Search and its thread
+            SpscQueue<AnalysisUpdate, QUEUE_CAPACITY> mUpdates;     ///< Worker to game thread
+            std::atomic<uint32_t> mGeneration;                      ///< Incremented for every new position
+            bool mWhiteToMove;                                      ///< Side to move at the analysed root
+    };
+}
@@ -0,0 +1,166 @@
+/**
+ * @file Search.h
+ * @brief Iterative-deepening alpha-beta search.
+ */
+#pragma once
+
+#include<atomic>
+#include<functional>
+#include<thread>
+#include"framework/Position.h"
+#include"engine/SearchTypes.h"
+#include"engine/TimeManager.h"
+#include"engine/TranspositionTable.h"
+
+namespace chess
+{
+    /**
+     * @brief Single-threaded game tree search.
+     *
+     * Iterative deepening over a negamax alpha-beta search with a quiescence
+     * search on captures at the leaves. Results are cached in a
+     * `TranspositionTable`, which may be shared with other searches. Moves
+     * are ordered by the table move, the previous iteration's principal
+     * variation, MVV-LVA for captures, two killer moves per ply and the
+     * history heuristic for the remaining quiet moves.
+     *
+     * The search works on its own copy of the position, so it can run on a
+     * worker thread while the game keeps rendering (see `SearchThread`).
+     *
+     * With more than one thread (`SetThreadCount`) the search is a Lazy
+     * SMP search: helper searches, each with its own position, killers,
+     * history and PV tables, search the same root at staggered depths on
+     * their own threads and share nothing but the transposition table.
+     * Node counts are per-thread relaxed atomics summed on demand.
+     */
+    class Search
+    {
+        public:
+            /** @brief Called after every completed iteration. */
+            using IterationCallback = std::function<void(const SearchResult&)>;
+
+            /**
+             * @brief Construct a search.
+             * @param table Transposition table to read and fill; must outlive the search
+             * @param threadIndex 0 for a main search, otherwise the index of a helper
+             */
+            explicit Search(TranspositionTable& table, int threadIndex = 0);
+
+            /** @brief Stops and joins the helper threads. */
+            ~Search();
+
+            Search(const Search&) = delete;
+            Search& operator=(const Search&) = delete;
+
+            /**
+             * @brief Number of threads `Run` searches with, including the calling one.
+             *
+             * Only call while no search is running.
+             */
+            void SetThreadCount(int threads);
+
+            /** @brief Threads `Run` searches with. */
+            int GetThreadCount() const { return static_cast<int>(mHelpers.size()) + 1; }
+
+            /**
+             * @brief Search a position until a limit is hit or `Stop` is called.
+             * @param position Root position
+             * @param limits Depth, node and time limits
+             * @param history Zobrist keys of the game positions before the root, oldest first, for repetition detection
+             * @return Result of the deepest completed iteration
+             */
+            SearchResult Run(const Position& position, const SearchLimits& limits, const List<uint64_t>& history = {});
+
+            /** @brief Ask a running search to return as soon as possible (thread safe). */
+            void Stop() { mStopRequested.store(true, std::memory_order_relaxed); }
+
+            /**
+             * @brief Re-arm the search after `Stop` and forget an old ponder hit.
+             *
+             * Call before starting a new search, on the thread that later
+             * forwards `PonderHit`, so a ponder hit that comes in before the
+             * search has started its clock is kept.
+             */
+            void ClearStop()
+            {
+                mStopRequested.store(false, std::memory_order_relaxed);
+                mTimeManager.ClearPonderHit();
+            }
+
+            /** @brief The pondered move was played: start the clock of a pondering search (thread safe). */
+            void PonderHit() { mTimeManager.PonderHit(); }
+
+            /** @brief Register a function receiving the result of each iteration (e.g. for UCI "info"). */
+            void SetIterationCallback(IterationCallback callback) { mIterationCallback = std::move(callback); }
+
+        private:
+            /** @brief Iterative deepening on the calling thread; `Run` without the helpers. */
+            SearchResult Iterate(const Position& position, const SearchLimits& limits, const List<uint64_t>& history);
+
+            /** @brief Stop the helpers and join their threads. */
+            void StopHelpers();
+
+            /** @brief Nodes of this search and all its helpers. */
+            uint64_t GetTotalNodes() const;
+
+            /** @brief Count a node; only this search's thread writes its counter. */
+            void CountNode() { mNodes.store(mNodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+            /**
+             * @brief Fail-soft negamax alpha-beta.
+             * @param depth Remaining depth in plies
+             * @param ply Distance from the root
+             * @param alpha Lower bound
+             * @param beta Upper bound
+             * @return Score for the side to move
+             */
+            int Negamax(int depth, int ply, int alpha, int beta);
+
+            /** @brief Resolve captures until the position is quiet, so leaves are not scored mid-exchange. */
+            int Quiescence(int ply, int alpha, int beta);
+
+            /** @brief Static evaluation for the side to move. */
+            int EvaluateForSideToMove() const;
+
+            /** @brief Fill `scores` with ordering scores for `moves`, trying `tableMove` first. */
+            void ScoreMoves(const MoveList& moves, int ply, Move tableMove, int* scores) const;
+
+            /** @brief Move the best scored remaining move to `index` (lazy selection sort). */
+            static void PickMove(MoveList& moves, int* scores, int index);
+
+            /** @brief True if the move captures something (en passant included). */
+            bool IsCapture(Move move) const;
+
+            /** @brief Fifty-move rule or a repetition of an earlier position. */
+            bool IsDraw() const;
+
+            /** @brief Poll the stop flag, node budget and clock. */
+            bool ShouldAbort();
+
+            /** @brief Play a move on the search position and remember its key. */
+            void MakeMove(Move move, UndoRecord& undo);
+
+            /** @brief Take back a move played with `MakeMove`. */
+            void UnmakeMove(const UndoRecord& undo);
+
+            TranspositionTable& mTable;         ///< Cache of earlier results, shared with the helpers
+            int mThreadIndex;                   ///< 0 for the main search, helpers count from 1
+            List<unique<Search>> mHelpers;      ///< Lazy SMP helper searches
+            List<std::thread> mHelperThreads;   ///< Threads running the helpers during `Run`
+            Position mPosition;                 ///< Position being searched
+            List<uint64_t> mHashStack;          ///< Keys of every position from the game start to the current node
+            SearchLimits mLimits;               ///< Limits of the running search
+            TimeManager mTimeManager;           ///< Deadlines of the running search
+            IterationCallback mIterationCallback; ///< Progress reporting
+
+            std::atomic<bool> mStopRequested;   ///< Set from other threads by `Stop`
+            bool mAborted;                      ///< Current iteration must unwind
+            std::atomic<uint64_t> mNodes;       ///< Nodes visited by this thread (read by the main search)
+
+            Move mKillers[MAX_PLY][2];                      ///< Quiet moves that caused a beta cutoff, per ply
+            int mHistory[2][SQUARE_COUNT][SQUARE_COUNT];    ///< [side][from][to] cutoff statistics of quiet moves
+            Move mPrincipalVariation[MAX_PLY][MAX_PLY];     ///< Triangular PV table
+            int mPrincipalVariationLength[MAX_PLY];         ///< Length of the PV starting at each ply
+            Move mPreviousVariation[MAX_PLY];               ///< PV of the last completed iteration, tried first
+    };
+}
@@ -0,0 +1,80 @@
+/**
+ * @file SearchThread.h
+ * @brief Runs a `Search` on a worker thread so the game loop never blocks.
+ */
+#pragma once
+
+#include<atomic>
+#include<mutex>
+#include<thread>
+#include"engine/Search.h"
+
+namespace chess
+{
+    /**
+     * @brief Owns a search and the thread it runs on.
+     *
+     * The game thread starts a search and polls for the result once per
+     * tick; it never waits on the search except when stopping it.
+     */
+    class SearchThread
+    {
+        public:
+            SearchThread();
+
+            /** @brief Stops and joins a running search. */
+            ~SearchThread();
+
+            SearchThread(const SearchThread&) = delete;
+            SearchThread& operator=(const SearchThread&) = delete;
+
+            /**
+             * @brief Start searching in the background, stopping any previous search first.
+             * @param position Root position (copied)
+             * @param limits Search limits
+             * @param history Keys of the game positions before the root
+             */
+            void Start(const Position& position, const SearchLimits& limits, const List<uint64_t>& history = {});
+
+            /** @brief Abort the running search and wait for the thread to finish. */
+            void Stop();
+
+            /**
+             * @brief Receive every completed iteration; the callback runs on the worker thread.
+             *
+             * Stops a running search first, since the search reads the callback.
+             */
+            void SetIterationCallback(Search::IterationCallback callback);
+
+            /**
+             * @brief Resize the transposition table, stopping a running search first.
+             * @param sizeMB Table size in megabytes
+             */
+            void SetHashSize(size_t sizeMB);
+
+            /** @brief Forget everything learned in earlier searches (e.g. for a new game). */
+            void ClearHash();
+
+            /** @brief Table shared by the searches run on this thread. */
+            TranspositionTable& GetTranspositionTable() { return mTable; }
+
+            /** @brief True while a search is running or its result has not been collected. */
+            bool IsSearching() const { return mSearching.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Collect the result of a finished search.
+             * @param result Receives the result
+             * @return True if a finished search was collected
+             */
+            bool PollResult(SearchResult& result);
+
+        private:
+            TranspositionTable mTable;      ///< Kept between searches so later moves reuse earlier work
+            Search mSearch;                 ///< Search state, only touched by the worker while it runs
+            std::thread mThread;            ///< Worker running `mSearch`
+            std::mutex mResultMutex;        ///< Guards `mResult`
+            SearchResult mResult;           ///< Result written by the worker
+            std::atomic<bool> mSearching;   ///< A search was started and not collected
+            std::atomic<bool> mFinished;    ///< The worker has written `mResult`
+    };
+}
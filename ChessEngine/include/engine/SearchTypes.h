@@ -0,0 +1,48 @@
+/**
+ * @file SearchTypes.h
+ * @brief Limits, results and score constants shared by the search components.
+ */
+#pragma once
+
+#include"framework/Move.h"
+
+namespace chess
+{
+    /** @brief Deepest ply the search can reach (sizes killer and PV tables). */
+    constexpr int MAX_PLY = 64;
+
+    constexpr int INFINITE_SCORE = 32000;           ///< Bound wider than any real score
+    constexpr int MATE_SCORE = 31000;               ///< Score of mate at the root; mate in n plies is MATE_SCORE - n
+    constexpr int MATE_BOUND = MATE_SCORE - MAX_PLY;///< Scores beyond this are mate scores
+
+    /**
+     * @brief What the search is allowed to spend.
+     *
+     * Times are in milliseconds; zero means "not given". Without a depth,
+     * node or time limit the search runs until stopped.
+     */
+    struct SearchLimits
+    {
+        int mMaxDepth = MAX_PLY - 1;    ///< Deepest iteration
+        int64_t mMoveTime = 0;          ///< Exact time to spend on this move
+        int64_t mTimeLeft[2] = {0, 0};  ///< [white, black] remaining clock time
+        int64_t mIncrement[2] = {0, 0}; ///< [white, black] increment per move
+        int mMovesToGo = 0;             ///< Moves until the next time control, 0 if sudden death
+        uint64_t mMaxNodes = 0;         ///< Node budget
+        bool mInfinite = false;         ///< Search until stopped
+        bool mPonder = false;           ///< Think on the opponent's time; the clock starts at `Search::PonderHit`
+    };
+
+    /**
+     * @brief Outcome of the last completed iteration.
+     */
+    struct SearchResult
+    {
+        Move mBestMove{};               ///< Move to play, null if there is no legal move
+        int mScore = 0;                 ///< Score for the side to move in centipawns (or mate score)
+        int mDepth = 0;                 ///< Depth of the last completed iteration
+        uint64_t mNodes = 0;            ///< Nodes searched so far
+        int64_t mTime = 0;              ///< Milliseconds spent so far
+        List<Move> mPrincipalVariation; ///< Expected line starting with mBestMove
+    };
+}
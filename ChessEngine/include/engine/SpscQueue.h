@@ -0,0 +1,66 @@
+/**
+ * @file SpscQueue.h
+ * @brief Bounded lock-free queue for one producer thread and one consumer thread.
+ */
+#pragma once
+
+#include<atomic>
+#include<cstddef>
+
+namespace chess
+{
+    /**
+     * @brief Fixed-capacity ring buffer with one writer and one reader.
+     *
+     * The producer only writes `mTail` and the consumer only writes `mHead`,
+     * so neither side ever waits for the other: a push into a full queue and
+     * a pop from an empty one simply fail. The indices sit on separate cache
+     * lines so the two threads do not contend for one.
+     *
+     * @tparam T Element type, copied in and out
+     * @tparam Capacity Number of slots, a power of two
+     */
+    template<typename T, size_t Capacity>
+    class SpscQueue
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+        public:
+            SpscQueue() :mHead{0}, mTail{0}, mBuffer{} {}
+
+            /**
+             * @brief Append an element (producer thread only).
+             * @return False if the queue is full and the element was dropped
+             */
+            bool TryPush(const T& value)
+            {
+                size_t tail = mTail.load(std::memory_order_relaxed);
+                if(tail - mHead.load(std::memory_order_acquire) == Capacity)
+                    return false;
+
+                mBuffer[tail & (Capacity - 1)] = value;
+                mTail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Take the oldest element (consumer thread only).
+             * @return False if the queue is empty
+             */
+            bool TryPop(T& value)
+            {
+                size_t head = mHead.load(std::memory_order_relaxed);
+                if(head == mTail.load(std::memory_order_acquire))
+                    return false;
+
+                value = mBuffer[head & (Capacity - 1)];
+                mHead.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            alignas(64) std::atomic<size_t> mHead;  ///< Next slot to read, written by the consumer
+            alignas(64) std::atomic<size_t> mTail;  ///< Next slot to write, written by the producer
+            T mBuffer[Capacity];                    ///< Slots
+    };
+}
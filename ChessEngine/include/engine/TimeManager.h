@@ -0,0 +1,73 @@
+/**
+ * @file TimeManager.h
+ * @brief Decides how long the search may think about one move.
+ */
+#pragma once
+
+#include<atomic>
+#include<chrono>
+#include<mutex>
+#include"engine/SearchTypes.h"
+
+namespace chess
+{
+    /**
+     * @brief Turns `SearchLimits` into a soft and a hard deadline.
+     *
+     * The soft limit is checked between iterations (no new iteration is
+     * started after it), the hard limit aborts the iteration in progress.
+     * While pondering neither limit applies; the deadlines count from the
+     * moment `PonderHit` is called.
+     *
+     * `PonderHit` usually comes from another thread and may even arrive
+     * before the search thread has called `Start`, so it is remembered
+     * until `ClearPonderHit` re-arms the manager for the next search.
+     */
+    class TimeManager
+    {
+        public:
+            TimeManager();
+
+            /**
+             * @brief Start the clock and compute the deadlines.
+             * @param limits Limits of this search
+             * @param whiteToMove Side whose clock is running
+             */
+            void Start(const SearchLimits& limits, bool whiteToMove);
+
+            /** @brief Milliseconds since `Start`. */
+            int64_t GetElapsed() const;
+
+            /** @brief True once another iteration is unlikely to finish in time. */
+            bool IsSoftLimitReached() const { return mSoftLimit > 0 && !IsPondering() && GetLimitElapsed() >= mSoftLimit; }
+
+            /** @brief True once the search must stop immediately. */
+            bool IsHardLimitReached() const { return mHardLimit > 0 && !IsPondering() && GetLimitElapsed() >= mHardLimit; }
+
+            /** @brief True while the search ponders and no deadline applies. */
+            bool IsPondering() const { return mPondering.load(std::memory_order_acquire); }
+
+            /** @brief The predicted move was played: start the clock now, or as soon as `Start` runs (thread safe). */
+            void PonderHit();
+
+            /** @brief Forget an earlier `PonderHit`; call before the next search is started. */
+            void ClearPonderHit();
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            static constexpr int64_t MOVE_OVERHEAD = 30;   ///< Milliseconds kept back for communication/GUI lag
+            static constexpr int DEFAULT_MOVES_TO_GO = 30;  ///< Assumed moves left in sudden death
+
+            /** @brief Milliseconds the deadlines have been running. */
+            int64_t GetLimitElapsed() const { return GetElapsed() - mLimitStart.load(std::memory_order_relaxed); }
+
+            std::mutex mMutex;                  ///< Orders `Start` against `PonderHit` from another thread
+            Clock::time_point mStart;           ///< When the search started; written under `mMutex`
+            int64_t mSoftLimit;                 ///< Stop iterating after this many ms (0 = none)
+            int64_t mHardLimit;                 ///< Abort after this many ms (0 = none)
+            std::atomic<bool> mPondering;       ///< Deadlines suspended until `PonderHit`
+            std::atomic<int64_t> mLimitStart;   ///< Elapsed ms at which the deadlines started
+            bool mPonderHit;                    ///< `PonderHit` arrived since `ClearPonderHit`; guarded by `mMutex`
+    };
+}
@@ -0,0 +1,155 @@
+/**
+ * @file TranspositionTable.h
+ * @brief Fixed-size, lock-free hash table of search results keyed by Zobrist key.
+ */
+#pragma once
+
+#include<atomic>
+#include"framework/Move.h"
+
+namespace chess
+{
+    /** @enum Bound
+    * @brief How a stored score relates to the true score of the position.
+    */
+    enum class Bound : uint8_t
+    {
+        None = 0,   ///< No score stored
+        Upper = 1,  ///< Search failed low: true score <= stored score
+        Lower = 2,  ///< Search failed high: true score >= stored score
+        Exact = 3   ///< Score inside the window
+    };
+
+    /**
+     * @brief Unpacked contents of one table entry.
+     */
+    struct TableEntry
+    {
+        Move mMove{};               ///< Best or refuting move, null if none
+        int mScore = 0;             ///< Score relative to the side to move
+        int mEval = 0;              ///< Static evaluation of the position
+        int mDepth = 0;             ///< Remaining depth the score was searched to
+        Bound mBound = Bound::None; ///< Meaning of `mScore`
+    };
+
+    /**
+     * @brief Shared transposition table.
+     *
+     * Entries are 16 bytes: the Zobrist key XOR the data word, then the data
+     * word. Four entries form a 64-byte, cache-line-aligned bucket, so a
+     * probe touches a single cache line. Threads read and write entries with
+     * relaxed atomics and no lock; a torn write (key of one store, data of
+     * another) no longer satisfies key ^ data == hash and is treated as a
+     * miss, so concurrent searches can share one table.
+     *
+     * Within a bucket the same position is overwritten in place; otherwise
+     * the shallowest entry is replaced, with entries from earlier searches
+     * counting as shallower the older they are.
+     *
+     * The data word holds a 48-bit payload, the depth, the bound and the age
+     * of the search that wrote it. Search entries pack move, score and
+     * evaluation into the payload; perft stores its leaf counts there.
+     */
+    class TranspositionTable
+    {
+        public:
+            /** @brief Size used when none is configured. */
+            static constexpr size_t DEFAULT_SIZE_MB = 16;
+
+            /**
+             * @brief Allocate a table.
+             * @param sizeMB Size in megabytes, rounded down to a power of two buckets
+             */
+            explicit TranspositionTable(size_t sizeMB = DEFAULT_SIZE_MB);
+
+            TranspositionTable(const TranspositionTable&) = delete;
+            TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+            /** @brief Reallocate and clear; not safe while a search is using the table. */
+            void Resize(size_t sizeMB);
+
+            /** @brief Forget every entry. */
+            void Clear();
+
+            /** @brief Start a new search: entries from earlier searches become replaceable. */
+            void NewSearch() { mAge = (mAge + 1) & AGE_MASK; }
+
+            /**
+             * @brief Look a position up.
+             * @param key Zobrist key of the position
+             * @param entry Receives the entry on a hit
+             * @return True if the position was found
+             */
+            bool Probe(uint64_t key, TableEntry& entry) const;
+
+            /**
+             * @brief Store a search result.
+             *
+             * A null move keeps the move already stored for the same position.
+             */
+            void Store(uint64_t key, Move move, int score, int eval, int depth, Bound bound);
+
+            /**
+             * @brief Look up a perft leaf count.
+             * @param key Zobrist key of the position
+             * @param depth Perft depth the count must have been computed for
+             * @param nodes Receives the count on a hit
+             */
+            bool ProbePerft(uint64_t key, int depth, uint64_t& nodes) const;
+
+            /** @brief Store a perft leaf count; counts that do not fit in the payload are skipped. */
+            void StorePerft(uint64_t key, int depth, uint64_t nodes);
+
+            /** @brief Permille of sampled entries written by the current search (UCI "hashfull"). */
+            int GetHashFull() const;
+
+            /** @brief Allocated size in megabytes. */
+            size_t GetSizeMB() const { return mBucketCount * sizeof(Bucket) / (1024 * 1024); }
+
+        private:
+            /**
+             * @brief One 16-byte slot.
+             */
+            struct Entry
+            {
+                std::atomic<uint64_t> mKey;     ///< Zobrist key XOR `mData`
+                std::atomic<uint64_t> mData;    ///< Packed payload, depth, bound and age
+            };
+
+            static constexpr int ENTRIES_PER_BUCKET = 4;
+
+            /**
+             * @brief Entries sharing one cache line.
+             */
+            struct alignas(64) Bucket
+            {
+                Entry mEntries[ENTRIES_PER_BUCKET];
+            };
+
+            static constexpr int PAYLOAD_BITS = 48;
+            static constexpr int DEPTH_SHIFT = 48;
+            static constexpr int BOUND_SHIFT = 56;
+            static constexpr int AGE_SHIFT = 58;
+            static constexpr uint64_t PAYLOAD_MASK = (UINT64_C(1) << PAYLOAD_BITS) - 1;
+            static constexpr uint8_t AGE_MASK = 0x3F;
+
+            /** @brief Bucket a key maps to. */
+            Bucket& GetBucket(uint64_t key) const { return mBuckets[key & (mBucketCount - 1)]; }
+
+            /** @brief Find the entry holding `key` in its bucket. */
+            bool Find(uint64_t key, uint64_t& data) const;
+
+            /** @brief Write a packed entry, choosing the slot by the replacement policy. */
+            void Write(uint64_t key, uint64_t payload, int depth, Bound bound);
+
+            /** @brief Searches since the entry was written, modulo the age range. */
+            int RelativeAge(uint64_t data) const { return (mAge - static_cast<int>(data >> AGE_SHIFT)) & AGE_MASK; }
+
+            static int DepthOf(uint64_t data) { return static_cast<int>((data >> DEPTH_SHIFT) & 0xFF); }
+            static Bound BoundOf(uint64_t data) { return static_cast<Bound>((data >> BOUND_SHIFT) & 0x3); }
+
+            unique<Bucket[]> mBuckets;  ///< Table storage
+            size_t mBucketCount;        ///< Number of buckets, a power of two
+            uint8_t mAge;               ///< Age of the current search
+    };
+}
@@ -0,0 +1,138 @@
+/**
+ * @file UciEngine.h
+ * @brief Drives an external UCI engine process for analysis.
+ */
+#pragma once
+
+#include<atomic>
+#include<mutex>
+#include<thread>
+#include"engine/AnalysisWorker.h"
+
+namespace chess
+{
+    /**
+     * @brief Runs a local UCI engine binary and streams its analysis.
+     *
+     * The engine is spawned with its stdin and stdout connected to pipes.
+     * A single I/O thread owns both pipes: it polls them without blocking,
+     * writes queued commands when the engine can take them, splits the
+     * output into lines and turns every `info` line with a score into an
+     * `AnalysisUpdate` on the same kind of queue `AnalysisWorker` uses, so
+     * the game thread consumes both the same way.
+     *
+     * Lines are assembled in a fixed buffer; an overlong line is cut off and
+     * the rest of it skipped, so a chatty engine cannot grow memory or stall
+     * the game thread, which only ever takes a short lock to post a request.
+     *
+     * Only one search runs at a time: a new position is sent after the
+     * engine has answered the previous `stop` with `bestmove`, so info lines
+     * are always attributed to the right position.
+     *
+     * Spawning is implemented for POSIX systems; elsewhere `Start` fails.
+     */
+    class UciEngine
+    {
+        public:
+            UciEngine();
+
+            /** @brief Quits the engine and joins the I/O thread. */
+            ~UciEngine();
+
+            UciEngine(const UciEngine&) = delete;
+            UciEngine& operator=(const UciEngine&) = delete;
+
+            /**
+             * @brief Spawn the engine and start the UCI handshake.
+             * @param path Engine executable, looked up on PATH if it has no slash
+             * @return False if the process could not be started
+             */
+            bool Start(const std::string& path);
+
+            /** @brief True while the engine process is alive and talking. */
+            bool IsRunning() const { return mRunning.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Analyse the position reached by a game until told otherwise ("go infinite").
+             * @param startPosition Position the game started from
+             * @param moves Moves played from `startPosition`; the position after them is analysed
+             */
+            void Analyse(const Position& startPosition, const List<Move>& moves);
+
+            /** @brief Stop analysing. */
+            void Stop();
+
+            /**
+             * @brief Take the next update of the current analysis (game thread).
+             * @return False if no new update is available
+             */
+            bool PollUpdate(AnalysisUpdate& update);
+
+        private:
+            /**
+             * @brief Analysis requested by the game thread, picked up by the I/O thread.
+             */
+            struct Request
+            {
+                bool mAnalyse = false;      ///< Search `mPosition`, otherwise just stop
+                uint32_t mGeneration = 0;   ///< Generation the updates are tagged with
+                Position mPosition{};       ///< Root position
+                std::string mCommand;       ///< "position fen ... moves ..."
+            };
+
+            /** @brief Poll loop of the I/O thread. */
+            void Run();
+
+            /** @brief Split freshly read bytes into lines. */
+            void ReadOutput(const char* data, size_t size);
+
+            /** @brief React to one complete line of engine output. */
+            void HandleLine(const std::string& line);
+
+            /** @brief Parse an `info` line into an update for the current search. */
+            void HandleInfo(const std::string& line);
+
+            /** @brief Stop the running search for a pending request, or send it once the engine is idle. */
+            void SendRequest();
+
+            /** @brief Queue a command for the engine (I/O thread only). */
+            void Send(const std::string& command);
+
+            /** @brief Wake the I/O thread out of its poll. */
+            void Wake();
+
+            /** @brief Close the pipes and reap the process. */
+            void Shutdown();
+
+            static constexpr size_t QUEUE_CAPACITY = 64;
+            static constexpr size_t MAX_LINE_LENGTH = 4096;
+
+            std::thread mThread;                                ///< I/O thread
+            std::atomic<bool> mRunning;                         ///< Engine alive
+            std::atomic<bool> mQuit;                            ///< Tells the I/O thread to quit the engine
+
+            std::mutex mRequestMutex;                           ///< Guards `mRequest` and `mHasRequest`
+            Request mRequest;                                   ///< Latest request, older ones are superseded
+            bool mHasRequest;                                   ///< `mRequest` has not been picked up
+            std::atomic<uint32_t> mGeneration;                  ///< Incremented for every request
+
+            SpscQueue<AnalysisUpdate, QUEUE_CAPACITY> mUpdates; ///< I/O to game thread
+
+            // Owned by the I/O thread once started.
+            int mProcess;                                       ///< Engine process id
+            int mToEngine;                                      ///< Write end of the engine's stdin
+            int mFromEngine;                                    ///< Read end of the engine's stdout
+            int mWakeRead;                                      ///< Self-pipe the game thread writes to
+            int mWakeWrite;                                     ///< Game thread end of the self-pipe
+            std::string mOutput;                                ///< Commands not yet written
+            char mLine[MAX_LINE_LENGTH];                        ///< Line being assembled
+            size_t mLineLength;                                 ///< Bytes in `mLine`
+            bool mLineTruncated;                                ///< Skipping the rest of an overlong line
+            bool mReady;                                        ///< Handshake done ("readyok" received)
+            bool mSearching;                                    ///< A "go" has not been answered with "bestmove"
+            bool mStopSent;                                     ///< "stop" was sent for the running search
+            Request mPending;                                   ///< Request taken from the game thread, not yet sent
+            bool mHasPending;                                   ///< `mPending` is waiting for the engine
+            Request mCurrent;                                   ///< Search the engine is running
+    };
+}
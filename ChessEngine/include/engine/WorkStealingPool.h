@@ -0,0 +1,88 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Fixed set of worker threads with per-worker task deques and stealing.
+ */
+#pragma once
+
+#include<atomic>
+#include<condition_variable>
+#include<deque>
+#include<functional>
+#include<mutex>
+#include<thread>
+#include"framework/Core.h"
+
+namespace chess
+{
+    /**
+     * @brief Runs independent tasks on a fixed number of threads.
+     *
+     * Every worker has its own deque: it takes its newest task from the
+     * back, and an idle worker steals the oldest task from the front of
+     * another's, so a worker stuck with long tasks (a long game, a big
+     * subtree) is relieved by the others without a shared queue everybody
+     * contends on. Tasks submitted from a worker go to its own deque, which
+     * lets a task split itself.
+     *
+     * Each task is told which worker runs it, so callers can keep one set
+     * of per-thread state (a `Search`, a `Position`) per worker index and
+     * never share it.
+     */
+    class WorkStealingPool
+    {
+        public:
+            /** @brief Work item; the argument is the index of the worker running it. */
+            using Task = std::function<void(int)>;
+
+            /**
+             * @brief Start the workers.
+             * @param threadCount Number of workers; 0 uses one per hardware thread
+             */
+            explicit WorkStealingPool(int threadCount = 0);
+
+            /** @brief Finishes every submitted task, then joins the workers. */
+            ~WorkStealingPool();
+
+            WorkStealingPool(const WorkStealingPool&) = delete;
+            WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+            /** @brief Number of workers (worker indices are 0 to count - 1). */
+            int GetThreadCount() const { return static_cast<int>(mThreads.size()); }
+
+            /** @brief Queue a task; from a worker of this pool it goes to that worker's own deque. */
+            void Submit(Task task);
+
+            /**
+             * @brief Block until few enough submitted tasks are unfinished.
+             * @param maxPending Unfinished tasks to tolerate; 0 waits for all of them
+             */
+            void Wait(size_t maxPending = 0);
+
+        private:
+            /**
+             * @brief Deque of one worker, on its own cache line.
+             */
+            struct alignas(64) Worker
+            {
+                std::mutex mMutex;      ///< Guards `mTasks`
+                std::deque<Task> mTasks;///< Owner pops the back, thieves the front
+            };
+
+            /** @brief Worker body: run own tasks, steal, or sleep until there is work. */
+            void Run(int index);
+
+            /** @brief Take a task from the worker's own deque, else steal one. */
+            bool TakeTask(int index, Task& task);
+
+            List<unique<Worker>> mWorkers;          ///< One deque per worker
+            List<std::thread> mThreads;             ///< Worker threads
+
+            std::mutex mSleepMutex;                 ///< Guards sleeping and waiting
+            std::condition_variable mWorkAvailable; ///< Wakes idle workers
+            std::condition_variable mTaskFinished;  ///< Wakes `Wait`
+            std::atomic<size_t> mQueued;            ///< Tasks submitted and not yet taken
+            std::atomic<size_t> mPending;           ///< Tasks submitted and not finished
+            std::atomic<size_t> mNextWorker;        ///< Round robin target for outside submissions
+            bool mQuit;                             ///< Workers exit once the deques are empty
+    };
+}
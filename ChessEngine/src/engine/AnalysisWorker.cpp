@@ -0,0 +1,76 @@
+/**
+ * @file AnalysisWorker.cpp
+ * @brief Background analysis and its update stream.
+ */
+#include"engine/AnalysisWorker.h"
+#include<algorithm>
+
+namespace chess
+{
+    AnalysisWorker::AnalysisWorker()
+        :mSearchThread{},
+        mUpdates{},
+        mGeneration{0},
+        mWhiteToMove{true}
+    {
+        mSearchThread.SetIterationCallback([this](const SearchResult& result){ PushIteration(result); });
+    }
+
+    /**
+     * @brief Restart an infinite search on `position`.
+     *
+     * The previous search is joined before the generation changes, so the
+     * worker can never tag an old result with the new generation.
+     */
+    void AnalysisWorker::Analyse(const Position &position, const List<uint64_t> &history)
+    {
+        mSearchThread.Stop();
+        mGeneration.fetch_add(1, std::memory_order_relaxed);
+        mWhiteToMove = position.IsWhiteToMove();
+
+        SearchLimits limits;
+        limits.mInfinite = true;
+        mSearchThread.Start(position, limits, history);
+    }
+
+    /**
+     * @brief Stop the search and invalidate anything still queued.
+     */
+    void AnalysisWorker::Stop()
+    {
+        mSearchThread.Stop();
+        mGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drain stale updates and return the first one of the current analysis.
+     */
+    bool AnalysisWorker::PollUpdate(AnalysisUpdate &update)
+    {
+        uint32_t generation = mGeneration.load(std::memory_order_relaxed);
+        while(mUpdates.TryPop(update))
+        {
+            if(update.mGeneration == generation)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Convert an iteration to a white-relative update and queue it.
+     *
+     * If the game thread has fallen behind and the queue is full the update
+     * is dropped; the next, deeper one supersedes it anyway.
+     */
+    void AnalysisWorker::PushIteration(const SearchResult &result)
+    {
+        AnalysisUpdate update;
+        update.mGeneration = mGeneration.load(std::memory_order_relaxed);
+        update.mDepth = result.mDepth;
+        update.mScore = mWhiteToMove ? result.mScore : -result.mScore;
+        update.mNodes = result.mNodes;
+        update.mVariationLength = std::min(static_cast<int>(result.mPrincipalVariation.size()), MAX_PLY);
+        std::copy(result.mPrincipalVariation.begin(), result.mPrincipalVariation.begin() + update.mVariationLength, update.mVariation);
+        mUpdates.TryPush(update);
+    }
+}
@@ -0,0 +1,546 @@
+/**
+ * @file Search.cpp
+ * @brief Iterative deepening, alpha-beta, quiescence and move ordering.
+ */
+#include"engine/Search.h"
+#include"framework/Evaluation.h"
+#include"framework/MoveGenerator.h"
+#include<algorithm>
+#include<cstring>
+
+namespace chess
+{
+    namespace
+    {
+        constexpr int TABLE_MOVE_SCORE  = 2000000;  ///< Best move stored in the transposition table
+        constexpr int PV_MOVE_SCORE     = 1000000;  ///< Move of the previous principal variation
+        constexpr int CAPTURE_SCORE     = 100000;   ///< Base of MVV-LVA capture scores
+        constexpr int PROMOTION_SCORE   = 90000;    ///< Quiet queen promotion
+        constexpr int FIRST_KILLER_SCORE  = 80000;  ///< Most recent killer move
+        constexpr int SECOND_KILLER_SCORE = 79000;  ///< Older killer move
+        constexpr int HISTORY_LIMIT     = 50000;    ///< History scores are halved once one reaches this
+
+        constexpr uint64_t NODES_BETWEEN_CHECKS = 2048; ///< How often the clock is read
+
+        constexpr int NO_EVAL = -INFINITE_SCORE;    ///< Stored when the static evaluation is unknown
+
+        /**
+         * @brief Which iterations a helper thread skips: helper i (cycling
+         * through 20 patterns) searches a depth only if
+         * ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) is even.
+         */
+        constexpr int SKIP_PATTERNS = 20;
+        constexpr int SKIP_SIZE[SKIP_PATTERNS]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+        constexpr int SKIP_PHASE[SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+        /** @brief Mate scores are stored relative to the node, not the root, so they stay valid at other plies. */
+        int ScoreToTable(int score, int ply)
+        {
+            if(score >= MATE_BOUND) return score + ply;
+            if(score <= -MATE_BOUND) return score - ply;
+            return score;
+        }
+
+        /** @brief Inverse of `ScoreToTable`. */
+        int ScoreFromTable(int score, int ply)
+        {
+            if(score >= MATE_BOUND) return score - ply;
+            if(score <= -MATE_BOUND) return score + ply;
+            return score;
+        }
+
+        /** @brief Whether a stored bound settles the node for the window. */
+        bool IsTableCutoff(const TableEntry& entry, int score, int alpha, int beta)
+        {
+            return entry.mBound == Bound::Exact
+                || (entry.mBound == Bound::Lower && score >= beta)
+                || (entry.mBound == Bound::Upper && score <= alpha);
+        }
+    }
+
+    Search::Search(TranspositionTable &table, int threadIndex)
+        :mTable{table},
+        mThreadIndex{threadIndex},
+        mHelpers{},
+        mHelperThreads{},
+        mPosition{},
+        mHashStack{},
+        mLimits{},
+        mTimeManager{},
+        mIterationCallback{},
+        mStopRequested{false},
+        mAborted{false},
+        mNodes{0},
+        mKillers{},
+        mHistory{},
+        mPrincipalVariation{},
+        mPrincipalVariationLength{},
+        mPreviousVariation{}
+    {
+    }
+
+    Search::~Search()
+    {
+        StopHelpers();
+    }
+
+    /**
+     * @brief Helpers are created idle; each owns its position, ordering tables and PV.
+     */
+    void Search::SetThreadCount(int threads)
+    {
+        StopHelpers();
+        mHelpers.clear();
+        for(int i = 1; i < threads; i++)
+            mHelpers.push_back(std::make_unique<Search>(mTable, i));
+    }
+
+    /**
+     * @brief Lazy SMP driver.
+     *
+     * Helpers search the same root without limits, filling the shared table
+     * with entries this thread then finds; only this thread's iterations
+     * are reported and returned. Once it is done the helpers are stopped.
+     */
+    SearchResult Search::Run(const Position &position, const SearchLimits &limits, const List<uint64_t> &history)
+    {
+        mTable.NewSearch();
+
+        SearchLimits helperLimits;
+        helperLimits.mMaxDepth = limits.mMaxDepth;
+        helperLimits.mInfinite = true;
+        for(unique<Search>& helper : mHelpers)
+        {
+            Search* search = helper.get();
+            search->ClearStop();
+            mHelperThreads.emplace_back([search, position, helperLimits, history]()
+            {
+                search->Iterate(position, helperLimits, history);
+            });
+        }
+
+        SearchResult result = Iterate(position, limits, history);
+        StopHelpers();
+        result.mNodes = GetTotalNodes();
+        return result;
+    }
+
+    void Search::StopHelpers()
+    {
+        for(unique<Search>& helper : mHelpers)
+            helper->Stop();
+        for(std::thread& thread : mHelperThreads)
+            thread.join();
+        mHelperThreads.clear();
+    }
+
+    uint64_t Search::GetTotalNodes() const
+    {
+        uint64_t nodes = mNodes.load(std::memory_order_relaxed);
+        for(const unique<Search>& helper : mHelpers)
+            nodes += helper->mNodes.load(std::memory_order_relaxed);
+        return nodes;
+    }
+
+    /**
+     * @brief Iterative deepening on this thread.
+     *
+     * Each iteration searches one ply deeper than the last, reusing its
+     * principal variation for move ordering. An iteration cut short by the
+     * clock is discarded; the result of the last completed one is returned.
+     * Helper threads skip some depths so that the threads spread over
+     * neighbouring iterations instead of all repeating the same one.
+     */
+    SearchResult Search::Iterate(const Position &position, const SearchLimits &limits, const List<uint64_t> &history)
+    {
+        mPosition = position;
+        mLimits = limits;
+        mHashStack = history;
+        mHashStack.push_back(position.GetHash());
+        mAborted = false;
+        mNodes.store(0, std::memory_order_relaxed);
+        std::memset(mKillers, 0, sizeof(mKillers));
+        std::memset(mHistory, 0, sizeof(mHistory));
+        std::memset(mPreviousVariation, 0, sizeof(mPreviousVariation));
+        mTimeManager.Start(limits, position.IsWhiteToMove());
+
+        SearchResult result;
+        MoveList rootMoves;
+        MoveGenerator::GenerateLegalMoves(position, rootMoves);
+        if(rootMoves.Empty())
+            return result;
+
+        // Always have something to play, even if the first iteration is aborted
+        result.mBestMove = rootMoves[0];
+
+        for(int depth = 1; depth <= std::min(limits.mMaxDepth, MAX_PLY - 1); depth++)
+        {
+            if(mThreadIndex > 0)
+            {
+                int pattern = (mThreadIndex - 1) % SKIP_PATTERNS;
+                if(((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2 != 0)
+                    continue;
+            }
+
+            int score = Negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+            if(mAborted)
+                break;
+
+            result.mScore = score;
+            result.mDepth = depth;
+            result.mNodes = GetTotalNodes();
+            result.mTime = mTimeManager.GetElapsed();
+            result.mPrincipalVariation.assign(mPrincipalVariation[0], mPrincipalVariation[0] + mPrincipalVariationLength[0]);
+            if(!result.mPrincipalVariation.empty())
+                result.mBestMove = result.mPrincipalVariation[0];
+
+            std::memset(mPreviousVariation, 0, sizeof(mPreviousVariation));
+            std::copy(result.mPrincipalVariation.begin(), result.mPrincipalVariation.end(), mPreviousVariation);
+
+            if(mIterationCallback)
+                mIterationCallback(result);
+
+            // A single legal move or a forced mate needs no deeper search
+            if(!limits.mInfinite && !mTimeManager.IsPondering() && (rootMoves.Size() == 1 || abs(score) >= MATE_BOUND))
+                break;
+            if(mTimeManager.IsSoftLimitReached())
+                break;
+        }
+
+        result.mNodes = mNodes.load(std::memory_order_relaxed);
+        result.mTime = mTimeManager.GetElapsed();
+        return result;
+    }
+
+    /**
+     * @brief Negamax with alpha-beta pruning.
+     *
+     * Checks extend the search by one ply so mates and forced sequences are
+     * not cut off at the horizon. Below the root a deep enough table entry
+     * ends the node right away; otherwise its move is searched first.
+     */
+    int Search::Negamax(int depth, int ply, int alpha, int beta)
+    {
+        mPrincipalVariationLength[ply] = 0;
+
+        if(ply > 0 && IsDraw())
+            return 0;
+
+        bool inCheck = mPosition.IsInCheck(mPosition.IsWhiteToMove());
+        if(inCheck)
+            depth++;
+
+        if(depth <= 0)
+            return Quiescence(ply, alpha, beta);
+
+        CountNode();
+        if(ShouldAbort())
+            return 0;
+
+        if(ply >= MAX_PLY - 1)
+            return EvaluateForSideToMove();
+
+        TableEntry entry;
+        Move tableMove{};
+        int eval = NO_EVAL;
+        if(mTable.Probe(mPosition.GetHash(), entry))
+        {
+            tableMove = entry.mMove;
+            eval = entry.mEval;
+            int tableScore = ScoreFromTable(entry.mScore, ply);
+            if(ply > 0 && entry.mDepth >= depth && IsTableCutoff(entry, tableScore, alpha, beta))
+                return tableScore;
+        }
+
+        MoveList moves;
+        MoveGenerator::GenerateLegalMoves(mPosition, moves);
+        if(moves.Empty())
+            return inCheck ? -MATE_SCORE + ply : 0;
+
+        int scores[MAX_MOVES];
+        ScoreMoves(moves, ply, tableMove, scores);
+
+        int originalAlpha = alpha;
+        int bestScore = -INFINITE_SCORE;
+        Move bestMove{};
+        UndoRecord undo;
+        for(int i = 0; i < moves.Size(); i++)
+        {
+            PickMove(moves, scores, i);
+            Move move = moves[i];
+            bool capture = IsCapture(move);
+
+            MakeMove(move, undo);
+            int score = -Negamax(depth - 1, ply + 1, -beta, -alpha);
+            UnmakeMove(undo);
+
+            if(mAborted)
+                return 0;
+
+            if(score <= bestScore)
+                continue;
+            bestScore = score;
+
+            if(score > alpha)
+            {
+                alpha = score;
+                bestMove = move;
+
+                // Triangular PV: this move followed by the child's line
+                mPrincipalVariation[ply][0] = move;
+                std::copy(mPrincipalVariation[ply + 1], mPrincipalVariation[ply + 1] + mPrincipalVariationLength[ply + 1], mPrincipalVariation[ply] + 1);
+                mPrincipalVariationLength[ply] = mPrincipalVariationLength[ply + 1] + 1;
+            }
+
+            if(alpha >= beta)
+            {
+                if(!capture && move.GetFlag() != MoveFlag::Promotion)
+                {
+                    if(mKillers[ply][0] != move)
+                    {
+                        mKillers[ply][1] = mKillers[ply][0];
+                        mKillers[ply][0] = move;
+                    }
+
+                    int& history = mHistory[mPosition.IsWhiteToMove() ? 0 : 1][move.GetFrom()][move.GetTo()];
+                    history += depth * depth;
+                    if(history >= HISTORY_LIMIT)
+                    {
+                        for(auto& side : mHistory)
+                            for(auto& from : side)
+                                for(int& entry : from)
+                                    entry /= 2;
+                    }
+                }
+                break;
+            }
+        }
+
+        Bound bound = bestScore >= beta ? Bound::Lower : (bestScore > originalAlpha ? Bound::Exact : Bound::Upper);
+        mTable.Store(mPosition.GetHash(), bestMove, ScoreToTable(bestScore, ply), eval, depth, bound);
+        return bestScore;
+    }
+
+    /**
+     * @brief Capture-only search with a stand-pat cutoff.
+     *
+     * When in check every evasion is searched instead, since standing pat
+     * is not an option. Table entries of any depth can end the node, and
+     * their stored evaluation saves evaluating the position again.
+     */
+    int Search::Quiescence(int ply, int alpha, int beta)
+    {
+        mPrincipalVariationLength[ply] = 0;
+        CountNode();
+        if(ShouldAbort())
+            return 0;
+
+        if(ply >= MAX_PLY - 1)
+            return EvaluateForSideToMove();
+
+        TableEntry entry;
+        Move tableMove{};
+        int eval = NO_EVAL;
+        if(mTable.Probe(mPosition.GetHash(), entry))
+        {
+            tableMove = entry.mMove;
+            eval = entry.mEval;
+            int tableScore = ScoreFromTable(entry.mScore, ply);
+            if(IsTableCutoff(entry, tableScore, alpha, beta))
+                return tableScore;
+        }
+
+        bool inCheck = mPosition.IsInCheck(mPosition.IsWhiteToMove());
+        int originalAlpha = alpha;
+        int bestScore = -INFINITE_SCORE;
+        Move bestMove{};
+        MoveList moves;
+        if(inCheck)
+        {
+            MoveGenerator::GenerateLegalMoves(mPosition, moves);
+            if(moves.Empty())
+                return -MATE_SCORE + ply;
+        }
+        else
+        {
+            if(eval == NO_EVAL)
+                eval = EvaluateForSideToMove();
+            bestScore = eval;
+            if(bestScore >= beta)
+            {
+                mTable.Store(mPosition.GetHash(), Move{}, ScoreToTable(bestScore, ply), eval, 0, Bound::Lower);
+                return bestScore;
+            }
+            alpha = std::max(alpha, bestScore);
+            MoveGenerator::GenerateLegalCaptures(mPosition, moves);
+        }
+
+        int scores[MAX_MOVES];
+        ScoreMoves(moves, ply, tableMove, scores);
+
+        UndoRecord undo;
+        for(int i = 0; i < moves.Size(); i++)
+        {
+            PickMove(moves, scores, i);
+
+            MakeMove(moves[i], undo);
+            int score = -Quiescence(ply + 1, -beta, -alpha);
+            UnmakeMove(undo);
+
+            if(mAborted)
+                return 0;
+
+            if(score > bestScore)
+            {
+                bestScore = score;
+                if(score > alpha)
+                {
+                    alpha = score;
+                    bestMove = moves[i];
+                }
+                if(alpha >= beta)
+                    break;
+            }
+        }
+
+        Bound bound = bestScore >= beta ? Bound::Lower : (bestScore > originalAlpha ? Bound::Exact : Bound::Upper);
+        mTable.Store(mPosition.GetHash(), bestMove, ScoreToTable(bestScore, ply), eval, 0, bound);
+        return bestScore;
+    }
+
+    /**
+     * @brief Negate the white-relative evaluation when black is to move.
+     */
+    int Search::EvaluateForSideToMove() const
+    {
+        int score = Evaluation::Evaluate(mPosition);
+        return mPosition.IsWhiteToMove() ? score : -score;
+    }
+
+    /**
+     * @brief Ordering: table move, previous PV move, captures by MVV-LVA,
+     * queen promotions, killers, then quiet moves by history.
+     */
+    void Search::ScoreMoves(const MoveList &moves, int ply, Move tableMove, int *scores) const
+    {
+        int side = mPosition.IsWhiteToMove() ? 0 : 1;
+        for(int i = 0; i < moves.Size(); i++)
+        {
+            Move move = moves[i];
+            if(tableMove.IsValid() && move == tableMove)
+            {
+                scores[i] = TABLE_MOVE_SCORE;
+            }
+            else if(move == mPreviousVariation[ply])
+            {
+                scores[i] = PV_MOVE_SCORE;
+            }
+            else if(IsCapture(move))
+            {
+                PieceType victim = move.GetFlag() == MoveFlag::EnPassant ? PieceType::whitePawn : mPosition.GetPieceOnSquare(move.GetTo());
+                PieceType attacker = mPosition.GetPieceOnSquare(move.GetFrom());
+                scores[i] = CAPTURE_SCORE + 10 * Evaluation::GetPieceValue(victim) - Evaluation::GetPieceValue(attacker) / 10;
+            }
+            else if(move.GetFlag() == MoveFlag::Promotion && move.GetPromotion(true) == PieceType::whiteQueen)
+            {
+                scores[i] = PROMOTION_SCORE;
+            }
+            else if(move == mKillers[ply][0])
+            {
+                scores[i] = FIRST_KILLER_SCORE;
+            }
+            else if(move == mKillers[ply][1])
+            {
+                scores[i] = SECOND_KILLER_SCORE;
+            }
+            else
+            {
+                scores[i] = mHistory[side][move.GetFrom()][move.GetTo()];
+            }
+        }
+    }
+
+    /**
+     * @brief Swap the highest scored move from `index` onwards into `index`.
+     *
+     * Cheaper than a full sort because a cutoff usually comes early.
+     */
+    void Search::PickMove(MoveList &moves, int *scores, int index)
+    {
+        int best = index;
+        for(int i = index + 1; i < moves.Size(); i++)
+        {
+            if(scores[i] > scores[best])
+                best = i;
+        }
+        std::swap(moves[index], moves[best]);
+        std::swap(scores[index], scores[best]);
+    }
+
+    /**
+     * @brief Whether the move takes a piece.
+     */
+    bool Search::IsCapture(Move move) const
+    {
+        return move.GetFlag() == MoveFlag::EnPassant || (mPosition.GetOccupancy(!mPosition.IsWhiteToMove()) & SquareBit(move.GetTo()));
+    }
+
+    /**
+     * @brief Draw by the fifty-move rule or by repetition.
+     *
+     * Inside the search a single repetition is scored as a draw: if the
+     * position is worth repeating once it is worth repeating again. Only
+     * positions since the last capture or pawn move can repeat.
+     */
+    bool Search::IsDraw() const
+    {
+        if(mPosition.GetHalfMoveClock() >= 100)
+            return true;
+
+        int size = static_cast<int>(mHashStack.size());
+        int reversible = std::min(size - 1, mPosition.GetHalfMoveClock());
+        for(int plies = 4; plies <= reversible; plies += 2)
+        {
+            if(mHashStack[size - 1 - plies] == mPosition.GetHash())
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check the stop conditions, reading the clock only every few thousand nodes.
+     */
+    bool Search::ShouldAbort()
+    {
+        if(mAborted)
+            return true;
+
+        uint64_t nodes = mNodes.load(std::memory_order_relaxed);
+        if(mStopRequested.load(std::memory_order_relaxed)
+            || (mLimits.mMaxNodes && nodes >= mLimits.mMaxNodes)
+            || (nodes % NODES_BETWEEN_CHECKS == 0 && mTimeManager.IsHardLimitReached())
+            || (nodes % NODES_BETWEEN_CHECKS == 0 && mLimits.mMaxNodes && !mHelpers.empty() && GetTotalNodes() >= mLimits.mMaxNodes))
+        {
+            mAborted = true;
+        }
+        return mAborted;
+    }
+
+    /**
+     * @brief Play a move and push the new key for repetition detection.
+     */
+    void Search::MakeMove(Move move, UndoRecord &undo)
+    {
+        mPosition.MakeMove(move, undo);
+        mHashStack.push_back(mPosition.GetHash());
+    }
+
+    /**
+     * @brief Take back a move and pop its key.
+     */
+    void Search::UnmakeMove(const UndoRecord &undo)
+    {
+        mHashStack.pop_back();
+        mPosition.UnmakeMove(undo);
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file SearchThread.cpp
+ * @brief Background search worker.
+ */
+#include"engine/SearchThread.h"
+
+namespace chess
+{
+    SearchThread::SearchThread()
+        :mTable{},
+        mSearch{mTable},
+        mThread{},
+        mResultMutex{},
+        mResult{},
+        mSearching{false},
+        mFinished{false}
+    {
+    }
+
+    SearchThread::~SearchThread()
+    {
+        Stop();
+    }
+
+    /**
+     * @brief Spawn a worker that searches a copy of the position.
+     */
+    void SearchThread::Start(const Position &position, const SearchLimits &limits, const List<uint64_t> &history)
+    {
+        Stop();
+
+        mSearch.ClearStop();
+        mFinished.store(false, std::memory_order_relaxed);
+        mSearching.store(true, std::memory_order_release);
+        mThread = std::thread([this, position, limits, history]()
+        {
+            SearchResult result = mSearch.Run(position, limits, history);
+            {
+                std::lock_guard<std::mutex> lock{mResultMutex};
+                mResult = std::move(result);
+            }
+            mFinished.store(true, std::memory_order_release);
+        });
+    }
+
+    /**
+     * @brief Signal the search and join the worker; the result is discarded.
+     */
+    void SearchThread::Stop()
+    {
+        mSearch.Stop();
+        if(mThread.joinable())
+            mThread.join();
+        mSearching.store(false, std::memory_order_release);
+        mFinished.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Forward the callback to the search while it is idle.
+     */
+    void SearchThread::SetIterationCallback(Search::IterationCallback callback)
+    {
+        Stop();
+        mSearch.SetIterationCallback(std::move(callback));
+    }
+
+    /**
+     * @brief The table may not change size under a running search.
+     */
+    void SearchThread::SetHashSize(size_t sizeMB)
+    {
+        Stop();
+        mTable.Resize(sizeMB);
+    }
+
+    /**
+     * @brief Stop any search, then clear the table.
+     */
+    void SearchThread::ClearHash()
+    {
+        Stop();
+        mTable.Clear();
+    }
+
+    /**
+     * @brief Hand over the result once the worker is done, then join it.
+     */
+    bool SearchThread::PollResult(SearchResult &result)
+    {
+        if(!mFinished.load(std::memory_order_acquire))
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock{mResultMutex};
+            result = std::move(mResult);
+        }
+        if(mThread.joinable())
+            mThread.join();
+        mFinished.store(false, std::memory_order_relaxed);
+        mSearching.store(false, std::memory_order_release);
+        return true;
+    }
+}
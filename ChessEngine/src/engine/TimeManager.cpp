@@ -0,0 +1,89 @@
+/**
+ * @file TimeManager.cpp
+ * @brief Time allocation for a single search.
+ */
+#include"engine/TimeManager.h"
+#include<algorithm>
+
+namespace chess
+{
+    TimeManager::TimeManager()
+        :mMutex{},
+        mStart{Clock::now()},
+        mSoftLimit{0},
+        mHardLimit{0},
+        mPondering{false},
+        mLimitStart{0},
+        mPonderHit{false}
+    {
+    }
+
+    /**
+     * @brief Allocate time for this move.
+     *
+     * A fixed move time is used as is. With a running clock the move gets an
+     * even share of the remaining time plus most of the increment, and may
+     * overrun that share up to four times when an iteration is in progress,
+     * but never beyond half of the remaining clock. When pondering, the
+     * same deadlines are computed but held back until the ponder hit; one
+     * that already arrived starts them right away.
+     */
+    void TimeManager::Start(const SearchLimits &limits, bool whiteToMove)
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mStart = Clock::now();
+        mSoftLimit = 0;
+        mHardLimit = 0;
+        mLimitStart.store(0, std::memory_order_relaxed);
+        mPondering.store(limits.mPonder && !mPonderHit, std::memory_order_release);
+
+        if(limits.mInfinite)
+            return;
+
+        if(limits.mMoveTime > 0)
+        {
+            mSoftLimit = mHardLimit = std::max<int64_t>(1, limits.mMoveTime - MOVE_OVERHEAD);
+            return;
+        }
+
+        int side = whiteToMove ? 0 : 1;
+        int64_t timeLeft = limits.mTimeLeft[side];
+        if(timeLeft <= 0)
+            return;
+
+        int movesToGo = limits.mMovesToGo > 0 ? limits.mMovesToGo : DEFAULT_MOVES_TO_GO;
+        int64_t available = std::max<int64_t>(1, timeLeft - MOVE_OVERHEAD);
+        int64_t share = available / movesToGo + limits.mIncrement[side] * 3 / 4;
+
+        mHardLimit = std::max<int64_t>(1, std::min(share * 4, available / 2));
+        mSoftLimit = std::max<int64_t>(1, std::min(share, mHardLimit));
+    }
+
+    /**
+     * @brief Switch from pondering to a normal timed search.
+     *
+     * Before `Start` this only leaves the flag behind; `Start` resets the
+     * clock and picks the flag up.
+     */
+    void TimeManager::PonderHit()
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mPonderHit = true;
+        mLimitStart.store(GetElapsed(), std::memory_order_relaxed);
+        mPondering.store(false, std::memory_order_release);
+    }
+
+    void TimeManager::ClearPonderHit()
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mPonderHit = false;
+    }
+
+    /**
+     * @brief Wall-clock time since the search started.
+     */
+    int64_t TimeManager::GetElapsed() const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - mStart).count();
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file TranspositionTable.cpp
+ * @brief Lock-free transposition table storage and replacement.
+ */
+#include"engine/TranspositionTable.h"
+#include<algorithm>
+
+namespace chess
+{
+    namespace
+    {
+        constexpr int HASH_FULL_SAMPLE = 1000;  ///< Entries inspected by `GetHashFull`
+
+        /** @brief Search payload: move in bits 0-15, score in 16-31, evaluation in 32-47. */
+        uint64_t PackSearchPayload(Move move, int score, int eval)
+        {
+            return static_cast<uint64_t>(move.GetData())
+                | (static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(score))) << 16)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(eval))) << 32);
+        }
+    }
+
+    TranspositionTable::TranspositionTable(size_t sizeMB)
+        :mBuckets{},
+        mBucketCount{0},
+        mAge{0}
+    {
+        Resize(sizeMB);
+    }
+
+    /**
+     * @brief Allocate the largest power-of-two bucket count that fits in `sizeMB`.
+     */
+    void TranspositionTable::Resize(size_t sizeMB)
+    {
+        size_t maxBuckets = (sizeMB < 1 ? 1 : sizeMB) * 1024 * 1024 / sizeof(Bucket);
+        size_t bucketCount = 1;
+        while(bucketCount * 2 <= maxBuckets)
+            bucketCount *= 2;
+
+        if(bucketCount != mBucketCount)
+        {
+            mBuckets.reset(new Bucket[bucketCount]);
+            mBucketCount = bucketCount;
+        }
+        Clear();
+    }
+
+    /**
+     * @brief Zero every entry; an all-zero entry never verifies against a non-zero key.
+     */
+    void TranspositionTable::Clear()
+    {
+        for(size_t i = 0; i < mBucketCount; i++)
+        {
+            for(Entry& entry : mBuckets[i].mEntries)
+            {
+                entry.mKey.store(0, std::memory_order_relaxed);
+                entry.mData.store(0, std::memory_order_relaxed);
+            }
+        }
+        mAge = 0;
+    }
+
+    /**
+     * @brief Unpack the stored search result.
+     */
+    bool TranspositionTable::Probe(uint64_t key, TableEntry &entry) const
+    {
+        uint64_t data;
+        if(!Find(key, data) || BoundOf(data) == Bound::None)
+            return false;
+
+        entry.mMove = Move::FromData(static_cast<uint16_t>(data & 0xFFFF));
+        entry.mScore = static_cast<int16_t>((data >> 16) & 0xFFFF);
+        entry.mEval = static_cast<int16_t>((data >> 32) & 0xFFFF);
+        entry.mDepth = DepthOf(data);
+        entry.mBound = BoundOf(data);
+        return true;
+    }
+
+    /**
+     * @brief Pack a search result, keeping the old move when none is given.
+     */
+    void TranspositionTable::Store(uint64_t key, Move move, int score, int eval, int depth, Bound bound)
+    {
+        if(!move.IsValid())
+        {
+            uint64_t data;
+            if(Find(key, data))
+                move = Move::FromData(static_cast<uint16_t>(data & 0xFFFF));
+        }
+        Write(key, PackSearchPayload(move, score, eval), depth, bound);
+    }
+
+    /**
+     * @brief Perft counts are exact and only valid for the depth they were counted at.
+     */
+    bool TranspositionTable::ProbePerft(uint64_t key, int depth, uint64_t &nodes) const
+    {
+        uint64_t data;
+        if(!Find(key, data) || DepthOf(data) != depth || BoundOf(data) != Bound::Exact)
+            return false;
+
+        nodes = data & PAYLOAD_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Store a leaf count as an exact entry.
+     */
+    void TranspositionTable::StorePerft(uint64_t key, int depth, uint64_t nodes)
+    {
+        if(nodes > PAYLOAD_MASK)
+            return;
+        Write(key, nodes, depth, Bound::Exact);
+    }
+
+    /**
+     * @brief Count entries of the current search in the first buckets.
+     */
+    int TranspositionTable::GetHashFull() const
+    {
+        int sampledBuckets = static_cast<int>(std::min<size_t>(mBucketCount, HASH_FULL_SAMPLE / ENTRIES_PER_BUCKET));
+        int used = 0;
+        for(int i = 0; i < sampledBuckets; i++)
+        {
+            for(const Entry& entry : mBuckets[i].mEntries)
+            {
+                uint64_t data = entry.mData.load(std::memory_order_relaxed);
+                if(BoundOf(data) != Bound::None && RelativeAge(data) == 0)
+                    used++;
+            }
+        }
+        return sampledBuckets ? used * 1000 / (sampledBuckets * ENTRIES_PER_BUCKET) : 0;
+    }
+
+    /**
+     * @brief Scan the key's bucket for an entry that verifies.
+     *
+     * Reading data before key means a concurrent writer can at worst leave
+     * us with a mismatched pair, which fails the XOR check.
+     */
+    bool TranspositionTable::Find(uint64_t key, uint64_t &data) const
+    {
+        for(const Entry& entry : GetBucket(key).mEntries)
+        {
+            uint64_t entryData = entry.mData.load(std::memory_order_relaxed);
+            if((entry.mKey.load(std::memory_order_relaxed) ^ entryData) == key)
+            {
+                data = entryData;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Replace-by-depth with aging.
+     *
+     * The same position is always refreshed unless the stored result is
+     * deeper, from this search and the new one is not exact. Otherwise the
+     * slot with the lowest depth minus a penalty per search of age is used.
+     */
+    void TranspositionTable::Write(uint64_t key, uint64_t payload, int depth, Bound bound)
+    {
+        depth = depth < 0 ? 0 : (depth > 0xFF ? 0xFF : depth);
+        uint64_t data = (payload & PAYLOAD_MASK)
+            | (static_cast<uint64_t>(depth) << DEPTH_SHIFT)
+            | (static_cast<uint64_t>(bound) << BOUND_SHIFT)
+            | (static_cast<uint64_t>(mAge) << AGE_SHIFT);
+
+        Bucket& bucket = GetBucket(key);
+        Entry* replace = nullptr;
+        int replaceWorth = 0;
+        for(Entry& entry : bucket.mEntries)
+        {
+            uint64_t entryData = entry.mData.load(std::memory_order_relaxed);
+            if((entry.mKey.load(std::memory_order_relaxed) ^ entryData) == key)
+            {
+                if(bound != Bound::Exact && RelativeAge(entryData) == 0 && DepthOf(entryData) > depth + 2)
+                    return;
+                replace = &entry;
+                break;
+            }
+
+            int worth = DepthOf(entryData) - 8 * RelativeAge(entryData);
+            if(!replace || worth < replaceWorth)
+            {
+                replace = &entry;
+                replaceWorth = worth;
+            }
+        }
+
+        replace->mKey.store(key ^ data, std::memory_order_relaxed);
+        replace->mData.store(data, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,488 @@
+/**
+ * @file UciEngine.cpp
+ * @brief UCI engine process, pipe I/O thread and `info` parsing.
+ */
+#include"engine/UciEngine.h"
+#include"framework/MoveGenerator.h"
+#include<chrono>
+#include<sstream>
+
+#ifndef _WIN32
+#include<csignal>
+#include<cerrno>
+#include<fcntl.h>
+#include<poll.h>
+#include<sys/wait.h>
+#include<unistd.h>
+#endif
+
+namespace chess
+{
+    namespace
+    {
+        constexpr size_t READ_CHUNK = 4096;                                 ///< Bytes read from the engine per call
+        constexpr std::chrono::milliseconds QUIT_GRACE{200};                ///< Time the engine gets to exit after "quit"
+
+        /**
+         * @brief Convert a UCI mate distance in moves to a search score.
+         *
+         * Positive distances mean the side to move mates, as in `Search`.
+         */
+        int MateToScore(int moves)
+        {
+            return moves > 0 ? MATE_SCORE - (2 * moves - 1) : -MATE_SCORE - 2 * moves;
+        }
+
+#ifndef _WIN32
+        /** @brief Make a descriptor non-blocking and keep it out of child processes. */
+        void ConfigureDescriptor(int descriptor)
+        {
+            fcntl(descriptor, F_SETFL, fcntl(descriptor, F_GETFL) | O_NONBLOCK);
+            fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+        }
+#endif
+    }
+
+    UciEngine::UciEngine()
+        :mThread{},
+        mRunning{false},
+        mQuit{false},
+        mRequestMutex{},
+        mRequest{},
+        mHasRequest{false},
+        mGeneration{0},
+        mUpdates{},
+        mProcess{-1},
+        mToEngine{-1},
+        mFromEngine{-1},
+        mWakeRead{-1},
+        mWakeWrite{-1},
+        mOutput{},
+        mLine{},
+        mLineLength{0},
+        mLineTruncated{false},
+        mReady{false},
+        mSearching{false},
+        mStopSent{false},
+        mPending{},
+        mHasPending{false},
+        mCurrent{}
+    {
+    }
+
+    UciEngine::~UciEngine()
+    {
+        mQuit.store(true, std::memory_order_release);
+        Wake();
+        if(mThread.joinable())
+            mThread.join();
+        Shutdown();
+    }
+
+    /**
+     * @brief Fork the engine with its stdin and stdout redirected to pipes.
+     *
+     * A failed exec shows up as end of file on the engine's output, which
+     * the I/O thread reports by clearing `IsRunning`.
+     */
+    bool UciEngine::Start(const std::string &path)
+    {
+#ifndef _WIN32
+        if(mThread.joinable())
+            return false;
+
+        int toEngine[2], fromEngine[2], wake[2];
+        if(pipe(toEngine) != 0)
+            return false;
+        if(pipe(fromEngine) != 0)
+        {
+            close(toEngine[0]); close(toEngine[1]);
+            return false;
+        }
+        if(pipe(wake) != 0)
+        {
+            close(toEngine[0]); close(toEngine[1]);
+            close(fromEngine[0]); close(fromEngine[1]);
+            return false;
+        }
+
+        pid_t process = fork();
+        if(process == 0)
+        {
+            dup2(toEngine[0], STDIN_FILENO);
+            dup2(fromEngine[1], STDOUT_FILENO);
+            for(int descriptor : {toEngine[0], toEngine[1], fromEngine[0], fromEngine[1], wake[0], wake[1]})
+                close(descriptor);
+            execlp(path.c_str(), path.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+
+        close(toEngine[0]);
+        close(fromEngine[1]);
+        if(process < 0)
+        {
+            for(int descriptor : {toEngine[1], fromEngine[0], wake[0], wake[1]})
+                close(descriptor);
+            return false;
+        }
+
+        // A dead engine must surface as EPIPE on write, not kill the game.
+        std::signal(SIGPIPE, SIG_IGN);
+
+        mProcess = process;
+        mToEngine = toEngine[1];
+        mFromEngine = fromEngine[0];
+        mWakeRead = wake[0];
+        mWakeWrite = wake[1];
+        for(int descriptor : {mToEngine, mFromEngine, mWakeRead, mWakeWrite})
+            ConfigureDescriptor(descriptor);
+
+        mRunning.store(true, std::memory_order_release);
+        Send("uci");
+        mThread = std::thread{&UciEngine::Run, this};
+        return true;
+#else
+        LOG("UCI engines are not supported on this platform: %s", path.c_str());
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Post the game; the I/O thread stops the current search and sends it.
+     *
+     * The moves are replayed here to get the root the engine's variations
+     * are resolved against.
+     */
+    void UciEngine::Analyse(const Position &startPosition, const List<Move> &moves)
+    {
+        Request request;
+        request.mAnalyse = true;
+        request.mGeneration = mGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+        request.mPosition = startPosition;
+        request.mCommand = "position fen " + startPosition.GetFen();
+        if(!moves.empty())
+        {
+            request.mCommand += " moves";
+            for(Move move : moves)
+            {
+                UndoRecord undo;
+                request.mPosition.MakeMove(move, undo);
+                request.mCommand += " " + move.ToString();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mRequestMutex};
+            mRequest = std::move(request);
+            mHasRequest = true;
+        }
+        Wake();
+    }
+
+    /**
+     * @brief Post a request without a position, which only stops the search.
+     */
+    void UciEngine::Stop()
+    {
+        Request request;
+        request.mGeneration = mGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+        {
+            std::lock_guard<std::mutex> lock{mRequestMutex};
+            mRequest = std::move(request);
+            mHasRequest = true;
+        }
+        Wake();
+    }
+
+    /**
+     * @brief Drain stale updates and return the first one of the current analysis.
+     */
+    bool UciEngine::PollUpdate(AnalysisUpdate &update)
+    {
+        uint32_t generation = mGeneration.load(std::memory_order_relaxed);
+        while(mUpdates.TryPop(update))
+        {
+            if(update.mGeneration == generation)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Wait for engine output, room in its input or a wake-up, and handle whichever came.
+     */
+    void UciEngine::Run()
+    {
+#ifndef _WIN32
+        char buffer[READ_CHUNK];
+        while(true)
+        {
+            if(mQuit.load(std::memory_order_acquire))
+            {
+                // Best effort: the engine is killed anyway if it ignores this.
+                mOutput += mSearching ? "stop\nquit\n" : "quit\n";
+                ssize_t written = write(mToEngine, mOutput.data(), mOutput.size());
+                (void)written;
+                break;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{mRequestMutex};
+                if(mHasRequest)
+                {
+                    mPending = std::move(mRequest);
+                    mHasPending = true;
+                    mHasRequest = false;
+                }
+            }
+            SendRequest();
+
+            pollfd descriptors[3] = {
+                {mFromEngine, POLLIN, 0},
+                {mWakeRead, POLLIN, 0},
+                {mToEngine, POLLOUT, 0}
+            };
+            int count = mOutput.empty() ? 2 : 3;
+            if(poll(descriptors, count, -1) < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                break;
+            }
+
+            if(descriptors[1].revents & POLLIN)
+            {
+                while(read(mWakeRead, buffer, sizeof(buffer)) > 0) {}
+            }
+
+            if(descriptors[0].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                ssize_t bytes;
+                while((bytes = read(mFromEngine, buffer, sizeof(buffer))) > 0)
+                    ReadOutput(buffer, static_cast<size_t>(bytes));
+                if(bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+                    break;
+            }
+
+            if(count == 3 && (descriptors[2].revents & (POLLOUT | POLLERR | POLLHUP)))
+            {
+                ssize_t written = write(mToEngine, mOutput.data(), mOutput.size());
+                if(written > 0)
+                    mOutput.erase(0, static_cast<size_t>(written));
+                else if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    break;
+            }
+        }
+        mRunning.store(false, std::memory_order_release);
+#endif
+    }
+
+    /**
+     * @brief Assemble lines in the fixed buffer, skipping what does not fit.
+     */
+    void UciEngine::ReadOutput(const char *data, size_t size)
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            char c = data[i];
+            if(c == '\n')
+            {
+                if(!mLineTruncated)
+                {
+                    size_t length = mLineLength;
+                    if(length > 0 && mLine[length - 1] == '\r')
+                        length--;
+                    HandleLine(std::string{mLine, length});
+                }
+                mLineLength = 0;
+                mLineTruncated = false;
+            }
+            else if(mLineLength < MAX_LINE_LENGTH)
+            {
+                mLine[mLineLength++] = c;
+            }
+            else
+            {
+                mLineTruncated = true;
+            }
+        }
+    }
+
+    /**
+     * @brief Advance the handshake, track the running search and pick up analysis.
+     */
+    void UciEngine::HandleLine(const std::string &line)
+    {
+        std::string keyword = line.substr(0, line.find(' '));
+        if(keyword == "info")
+        {
+            if(mSearching && !mStopSent)
+                HandleInfo(line);
+        }
+        else if(keyword == "bestmove")
+        {
+            mSearching = false;
+            mStopSent = false;
+        }
+        else if(keyword == "uciok")
+        {
+            Send("isready");
+        }
+        else if(keyword == "readyok")
+        {
+            mReady = true;
+        }
+    }
+
+    /**
+     * @brief Read depth, score, nodes and the principal variation.
+     *
+     * Lines without a score (current move, hash usage) and bound-only scores
+     * from aspiration windows are skipped. The variation is resolved against
+     * the root position and cut at the first move that is not legal.
+     */
+    void UciEngine::HandleInfo(const std::string &line)
+    {
+        AnalysisUpdate update;
+        update.mGeneration = mCurrent.mGeneration;
+        bool hasScore = false;
+
+        std::istringstream stream{line};
+        std::string token;
+        stream >> token;
+        while(stream >> token)
+        {
+            if(token == "depth")
+            {
+                stream >> update.mDepth;
+            }
+            else if(token == "nodes")
+            {
+                stream >> update.mNodes;
+            }
+            else if(token == "score")
+            {
+                std::string type;
+                int value = 0;
+                stream >> type >> value;
+                if(type == "cp")
+                {
+                    update.mScore = value;
+                    hasScore = true;
+                }
+                else if(type == "mate")
+                {
+                    update.mScore = MateToScore(value);
+                    hasScore = true;
+                }
+            }
+            else if(token == "lowerbound" || token == "upperbound")
+            {
+                return;
+            }
+            else if(token == "pv")
+            {
+                Position position = mCurrent.mPosition;
+                while(update.mVariationLength < MAX_PLY && stream >> token)
+                {
+                    Move move = MoveGenerator::ParseMove(position, token);
+                    UndoRecord undo;
+                    if(!move.IsValid() || !position.MakeMove(move, undo))
+                        break;
+                    update.mVariation[update.mVariationLength++] = move;
+                }
+                break;
+            }
+        }
+
+        if(!hasScore || update.mDepth <= 0)
+            return;
+        if(!mCurrent.mPosition.IsWhiteToMove())
+            update.mScore = -update.mScore;
+        mUpdates.TryPush(update);
+    }
+
+    /**
+     * @brief The engine runs one search at a time, so a new one waits for "bestmove".
+     */
+    void UciEngine::SendRequest()
+    {
+        if(!mReady || !mHasPending)
+            return;
+
+        if(mSearching)
+        {
+            if(!mStopSent)
+            {
+                Send("stop");
+                mStopSent = true;
+            }
+            return;
+        }
+
+        if(mPending.mAnalyse)
+        {
+            Send(mPending.mCommand);
+            Send("go infinite");
+            mSearching = true;
+            mStopSent = false;
+        }
+        mCurrent = std::move(mPending);
+        mHasPending = false;
+    }
+
+    /**
+     * @brief Buffer the command; the poll loop writes it as the pipe accepts it.
+     */
+    void UciEngine::Send(const std::string &command)
+    {
+        mOutput += command;
+        mOutput += '\n';
+    }
+
+    /**
+     * @brief One byte on the self-pipe; a full pipe already guarantees a wake-up.
+     */
+    void UciEngine::Wake()
+    {
+#ifndef _WIN32
+        if(mWakeWrite >= 0)
+        {
+            char byte = 0;
+            ssize_t written = write(mWakeWrite, &byte, 1);
+            (void)written;
+        }
+#endif
+    }
+
+    /**
+     * @brief Give the engine a moment to exit after "quit", then kill it.
+     */
+    void UciEngine::Shutdown()
+    {
+#ifndef _WIN32
+        for(int* descriptor : {&mToEngine, &mFromEngine, &mWakeRead, &mWakeWrite})
+        {
+            if(*descriptor >= 0)
+                close(*descriptor);
+            *descriptor = -1;
+        }
+
+        if(mProcess > 0)
+        {
+            auto deadline = std::chrono::steady_clock::now() + QUIT_GRACE;
+            while(waitpid(mProcess, nullptr, WNOHANG) == 0)
+            {
+                if(std::chrono::steady_clock::now() >= deadline)
+                {
+                    kill(mProcess, SIGKILL);
+                    waitpid(mProcess, nullptr, 0);
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{5});
+            }
+            mProcess = -1;
+        }
+#endif
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Worker loop, submission and stealing.
+ */
+#include"engine/WorkStealingPool.h"
+#include<algorithm>
+
+namespace chess
+{
+    namespace
+    {
+        thread_local const WorkStealingPool* sCurrentPool = nullptr; ///< Pool the calling thread works for
+        thread_local int sCurrentWorker = -1;                        ///< Its worker index in that pool
+    }
+
+    WorkStealingPool::WorkStealingPool(int threadCount)
+        :mWorkers{},
+        mThreads{},
+        mSleepMutex{},
+        mWorkAvailable{},
+        mTaskFinished{},
+        mQueued{0},
+        mPending{0},
+        mNextWorker{0},
+        mQuit{false}
+    {
+        if(threadCount <= 0)
+            threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+        for(int i = 0; i < threadCount; i++)
+            mWorkers.push_back(std::make_unique<Worker>());
+        for(int i = 0; i < threadCount; i++)
+            mThreads.emplace_back(&WorkStealingPool::Run, this, i);
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        Wait();
+        {
+            std::lock_guard<std::mutex> lock{mSleepMutex};
+            mQuit = true;
+        }
+        mWorkAvailable.notify_all();
+        for(std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    /**
+     * @brief Count the task under the sleep lock so no worker misses it, then push it to a deque.
+     *
+     * The count goes up first: a worker may take the task the moment it is
+     * pushed, and its decrement must never run ahead of this increment.
+     */
+    void WorkStealingPool::Submit(Task task)
+    {
+        int index = sCurrentPool == this
+            ? sCurrentWorker
+            : static_cast<int>(mNextWorker.fetch_add(1, std::memory_order_relaxed) % mWorkers.size());
+
+        mPending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock{mSleepMutex};
+            mQueued.fetch_add(1, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock{mWorkers[index]->mMutex};
+            mWorkers[index]->mTasks.push_back(std::move(task));
+        }
+        mWorkAvailable.notify_one();
+    }
+
+    void WorkStealingPool::Wait(size_t maxPending)
+    {
+        std::unique_lock<std::mutex> lock{mSleepMutex};
+        mTaskFinished.wait(lock, [this, maxPending](){ return mPending.load(std::memory_order_acquire) <= maxPending; });
+    }
+
+    /**
+     * @brief Own deque from the back (most recent, still in cache), others from the front (oldest, usually biggest).
+     */
+    bool WorkStealingPool::TakeTask(int index, Task &task)
+    {
+        int count = static_cast<int>(mWorkers.size());
+        for(int offset = 0; offset < count; offset++)
+        {
+            Worker& worker = *mWorkers[(index + offset) % count];
+            std::lock_guard<std::mutex> lock{worker.mMutex};
+            if(worker.mTasks.empty())
+                continue;
+
+            if(offset == 0)
+            {
+                task = std::move(worker.mTasks.back());
+                worker.mTasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.mTasks.front());
+                worker.mTasks.pop_front();
+            }
+            mQueued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void WorkStealingPool::Run(int index)
+    {
+        sCurrentPool = this;
+        sCurrentWorker = index;
+
+        Task task;
+        while(true)
+        {
+            if(TakeTask(index, task))
+            {
+                task(index);
+                task = nullptr;
+                {
+                    // Under the lock so a waiter cannot check the count and miss the notification
+                    std::lock_guard<std::mutex> lock{mSleepMutex};
+                    mPending.fetch_sub(1, std::memory_order_acq_rel);
+                }
+                mTaskFinished.notify_all();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{mSleepMutex};
+            mWorkAvailable.wait(lock, [this](){ return mQuit || mQueued.load(std::memory_order_relaxed) > 0; });
+            if(mQuit && mQueued.load(std::memory_order_relaxed) == 0)
+                return;
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file FakeUciEngine.cpp
+ * @brief Scripted stand-in for a UCI engine, driven by UciEngineTest.
+ *
+ * Answers the handshake, and on every "go" prints an overlong info line
+ * followed by a normal one. "stop" is answered with "bestmove" only after
+ * a short delay; a command arriving in that window means the adapter did
+ * not wait for "bestmove" and is logged as an error.
+ *
+ * FAKE_UCI_LOG names a file that receives every command and error.
+ * FAKE_UCI_MODE=exit makes the engine exit in the middle of its first search.
+ */
+#include<cstdio>
+#include<cstdlib>
+#include<string>
+#include<poll.h>
+#include<unistd.h>
+
+namespace
+{
+    /** @brief Longer than the adapter's line buffer, so the line has to be dropped. */
+    constexpr int OVERLONG_PV_MOVES = 1200;
+
+    /** @brief How long "bestmove" is held back after "stop". */
+    constexpr int BESTMOVE_DELAY_MS = 100;
+
+    std::string sPending; ///< Bytes read from stdin past the last returned line
+
+    /**
+     * @brief Read one line from stdin without stdio buffering, so `poll` sees what is still unread.
+     * @return False at end of input
+     */
+    bool ReadLine(std::string& line)
+    {
+        while(true)
+        {
+            size_t end = sPending.find('\n');
+            if(end != std::string::npos)
+            {
+                line = sPending.substr(0, end);
+                sPending.erase(0, end + 1);
+                return true;
+            }
+            char buffer[256];
+            ssize_t bytes = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if(bytes <= 0)
+                return false;
+            sPending.append(buffer, static_cast<size_t>(bytes));
+        }
+    }
+
+    void Reply(const std::string& line)
+    {
+        std::fputs((line + "\n").c_str(), stdout);
+        std::fflush(stdout);
+    }
+}
+
+int main()
+{
+    const char* logPath = std::getenv("FAKE_UCI_LOG");
+    const char* mode = std::getenv("FAKE_UCI_MODE");
+    bool exitInSearch = mode && std::string{mode} == "exit";
+    std::FILE* log = logPath ? std::fopen(logPath, "w") : nullptr;
+    auto record = [log](const std::string& text)
+    {
+        if(!log) return;
+        std::fputs((text + "\n").c_str(), log);
+        std::fflush(log);
+    };
+
+    std::string line;
+    while(ReadLine(line))
+    {
+        record(line);
+        std::string keyword = line.substr(0, line.find(' '));
+        if(keyword == "uci")
+        {
+            Reply("id name FakeUciEngine");
+            Reply("uciok");
+        }
+        else if(keyword == "isready")
+        {
+            Reply("readyok");
+        }
+        else if(keyword == "go")
+        {
+            if(exitInSearch)
+            {
+                Reply("info depth 1 score cp 5 pv e2e4");
+                return 0;
+            }
+            std::string overlong = "info depth 9 score cp 999 pv";
+            for(int i = 0; i < OVERLONG_PV_MOVES; i++)
+                overlong += " e2e4";
+            Reply(overlong);
+            Reply("info depth 1 score cp 17 nodes 100 pv e2e4 e7e5");
+        }
+        else if(keyword == "stop")
+        {
+            // Only "quit" may follow "stop" before the search has answered
+            pollfd input{STDIN_FILENO, POLLIN, 0};
+            if(sPending.empty() && poll(&input, 1, BESTMOVE_DELAY_MS) > 0)
+            {
+                char buffer[256];
+                ssize_t bytes = read(STDIN_FILENO, buffer, sizeof(buffer));
+                if(bytes > 0)
+                    sPending.append(buffer, static_cast<size_t>(bytes));
+            }
+            if(!sPending.empty() && sPending.compare(0, 4, "quit") != 0)
+                record("error: command sent before bestmove");
+            Reply("bestmove e2e4");
+        }
+        else if(keyword == "quit")
+        {
+            break;
+        }
+    }
+
+    if(log)
+        std::fclose(log);
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file UciEngineTest.cpp
+ * @brief Drives `UciEngine` against FakeUciEngine and checks what both sides saw.
+ *
+ * Usage: UciEngineTest <path to FakeUciEngine>
+ */
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<fstream>
+#include<functional>
+#include<string>
+#include<thread>
+#include<unistd.h>
+#include"engine/UciEngine.h"
+#include"framework/MoveGenerator.h"
+
+namespace
+{
+    /** @brief How long any expected reaction of the engine may take. */
+    constexpr std::chrono::seconds TIMEOUT{5};
+
+    int sFailures = 0;
+
+    void Check(bool pass, const char* what)
+    {
+        if(!pass) sFailures++;
+        std::printf("%s  %s\n", pass ? "ok  " : "FAIL", what);
+    }
+
+    /** @brief Poll `condition` until it holds or `TIMEOUT` passes. */
+    bool WaitFor(const std::function<bool()>& condition)
+    {
+        auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while(!condition())
+        {
+            if(std::chrono::steady_clock::now() >= deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+        return true;
+    }
+
+    /** @brief Wait for an update of the current analysis; the overlong depth 9 line must never show up. */
+    bool WaitForUpdate(chess::UciEngine& engine, chess::AnalysisUpdate& update)
+    {
+        bool sawOverlong = false;
+        bool received = WaitFor([&]()
+        {
+            if(!engine.PollUpdate(update))
+                return false;
+            sawOverlong = sawOverlong || update.mDepth == 9;
+            return update.mDepth == 1;
+        });
+        Check(!sawOverlong, "overlong info line is dropped");
+        return received;
+    }
+
+    /** @brief Every line the fake engine logged, in order. */
+    std::string ReadLog(const std::string& path)
+    {
+        std::ifstream file{path};
+        std::string log, line;
+        while(std::getline(file, line))
+            log += line + "\n";
+        return log;
+    }
+
+    /**
+     * @brief Handshake, analysis of two positions and the stop/bestmove ordering between them.
+     */
+    void TestAnalysis(const std::string& enginePath, const std::string& logPath)
+    {
+        setenv("FAKE_UCI_LOG", logPath.c_str(), 1);
+        setenv("FAKE_UCI_MODE", "normal", 1);
+
+        chess::Position start;
+        start.ResetToStartPosition();
+        chess::List<chess::Move> moves{chess::MoveGenerator::ParseMove(start, "e2e4")};
+        {
+            chess::UciEngine engine;
+            Check(engine.Start(enginePath), "engine starts");
+
+            chess::AnalysisUpdate update;
+            engine.Analyse(start, {});
+            Check(WaitForUpdate(engine, update), "handshake completes and analysis arrives");
+            Check(update.mScore == 17 && update.mVariationLength == 2, "info line is parsed with its variation");
+
+            engine.Analyse(start, moves);
+            Check(WaitForUpdate(engine, update), "analysis of the next position arrives");
+            Check(update.mScore == -17, "black's score is turned to white's point of view");
+            Check(engine.IsRunning(), "engine is still running");
+        }
+
+        std::string log = ReadLog(logPath);
+        std::string expected = std::string{"uci\nisready\nposition fen "} + chess::Position::START_FEN + "\ngo infinite\nstop\n"
+            + "position fen " + chess::Position::START_FEN + " moves e2e4\ngo infinite\n";
+        Check(log.compare(0, expected.size(), expected) == 0, "commands are sent in protocol order");
+        Check(log.find("error") == std::string::npos, "next position waits for bestmove");
+        if(sFailures > 0)
+            std::printf("Engine log:\n%s", log.c_str());
+    }
+
+    /**
+     * @brief An engine that exits during a search must show up as not running.
+     */
+    void TestEngineExit(const std::string& enginePath)
+    {
+        unsetenv("FAKE_UCI_LOG");
+        setenv("FAKE_UCI_MODE", "exit", 1);
+
+        chess::Position start;
+        start.ResetToStartPosition();
+        chess::UciEngine engine;
+        Check(engine.Start(enginePath), "exiting engine starts");
+        engine.Analyse(start, {});
+        Check(WaitFor([&engine](){ return !engine.IsRunning(); }), "engine exiting mid-search stops IsRunning");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc != 2)
+    {
+        std::printf("Usage: UciEngineTest <path to FakeUciEngine>\n");
+        return 2;
+    }
+
+    std::string logPath = "FakeUciEngine." + std::to_string(getpid()) + ".log";
+    TestAnalysis(argv[1], logPath);
+    std::remove(logPath.c_str());
+    TestEngineExit(argv[1]);
+
+    std::printf("\n%d failed\n", sFailures);
+    return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file UciProtocol.h
+ * @brief Universal Chess Interface front-end for the search.
+ */
+#pragma once
+
+#include<condition_variable>
+#include<iosfwd>
+#include<mutex>
+#include<thread>
+#include"engine/Search.h"
+
+namespace chess
+{
+    /**
+     * @brief Speaks UCI on a pair of streams and runs the search behind it.
+     *
+     * The caller's thread only reads commands; every `go` runs on a worker
+     * thread, so `stop`, `ponderhit` and `isready` are answered while the
+     * search is thinking. The search polls its stop flag at every node, so
+     * `stop` takes effect within milliseconds.
+     *
+     * `bestmove` is held back while the GUI still expects the search to run
+     * ("go infinite", or "go ponder" before `ponderhit`) and sent as soon as
+     * `stop` or `ponderhit` arrives. Output from both threads is serialized.
+     */
+    class UciProtocol
+    {
+        public:
+            /**
+             * @brief Construct the front-end.
+             * @param input Command stream (usually stdin)
+             * @param output Response stream (usually stdout)
+             */
+            UciProtocol(std::istream& input, std::ostream& output);
+
+            /** @brief Stops a running search. */
+            ~UciProtocol();
+
+            UciProtocol(const UciProtocol&) = delete;
+            UciProtocol& operator=(const UciProtocol&) = delete;
+
+            /** @brief Process commands until `quit` or the end of the input. */
+            void Run();
+
+        private:
+            /**
+             * @brief Handle one command line.
+             * @return False on `quit`
+             */
+            bool HandleCommand(const std::string& line);
+
+            /** @brief "uci": identify and list the options. */
+            void HandleUci();
+
+            /** @brief "setoption name <name> value <value>". */
+            void HandleSetOption(std::istringstream& arguments);
+
+            /** @brief "position [startpos | fen <fen>] [moves <move>...]". */
+            void HandlePosition(std::istringstream& arguments);
+
+            /** @brief "go" with its limits; starts the worker. */
+            void HandleGo(std::istringstream& arguments);
+
+            /** @brief "ponderhit": the pondered move was played, start the clock. */
+            void HandlePonderHit();
+
+            /** @brief Abort the search, release a held `bestmove` and join the worker. */
+            void StopSearch();
+
+            /** @brief Worker body: search, report and send `bestmove`. */
+            void SearchWorker(SearchLimits limits);
+
+            /** @brief Print an "info" line for a completed iteration (worker thread). */
+            void SendInfo(const SearchResult& result);
+
+            /** @brief Write one line and flush it, from either thread. */
+            void Send(const std::string& line);
+
+            static constexpr int DEFAULT_HASH_MB = 16;
+            static constexpr int MAX_HASH_MB = 4096;
+            static constexpr int MAX_THREADS = 256;
+
+            std::istream& mInput;                   ///< Command stream
+            std::ostream& mOutput;                  ///< Response stream
+            std::mutex mOutputMutex;                ///< Serializes `mOutput`
+
+            TranspositionTable mTable;              ///< Shared by consecutive searches of a game
+            Search mSearch;                         ///< Search run by the worker, with its Lazy SMP helpers
+            std::thread mWorker;                    ///< Thread of the current `go`
+
+            Position mPosition;                     ///< Root set by "position"
+            List<uint64_t> mHistory;                ///< Keys of the game positions before the root
+            bool mHasPosition;                      ///< False after a "position" the engine could not set up
+
+            std::mutex mStateMutex;                 ///< Guards the flags below
+            std::condition_variable mStateChanged;  ///< Signals `stop` and `ponderhit` to a waiting worker
+            bool mWaitForStop;                      ///< Hold `bestmove` until `stop` (infinite or pondering)
+            bool mStopReceived;                     ///< `stop` arrived for the current search
+    };
+}
@@ -0,0 +1,15 @@
+#include<iostream>
+#include"uci/UciProtocol.h"
+
+int main()
+{
+    // The GUI reads our answers as they come; never hold them in a buffer.
+    // Untie cin so reading never flushes cout outside the output lock.
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    std::cout.setf(std::ios::unitbuf);
+
+    chess::UciProtocol protocol{std::cin, std::cout};
+    protocol.Run();
+    return 0;
+}
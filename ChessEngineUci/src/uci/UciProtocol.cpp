@@ -0,0 +1,292 @@
+/**
+ * @file UciProtocol.cpp
+ * @brief UCI command parsing, search worker and output formatting.
+ */
+#include"uci/UciProtocol.h"
+#include"framework/MoveGenerator.h"
+#include<algorithm>
+#include<cstdlib>
+#include<iostream>
+#include<sstream>
+
+namespace chess
+{
+    namespace
+    {
+        /** @brief "cp <n>" or "mate <moves>" as UCI expects, from the side to move's point of view. */
+        std::string FormatScore(int score)
+        {
+            if(score >= MATE_BOUND)
+                return "mate " + std::to_string((MATE_SCORE - score + 1) / 2);
+            if(score <= -MATE_BOUND)
+                return "mate " + std::to_string(-(MATE_SCORE + score) / 2);
+            return "cp " + std::to_string(score);
+        }
+    }
+
+    UciProtocol::UciProtocol(std::istream &input, std::ostream &output)
+        :mInput{input},
+        mOutput{output},
+        mOutputMutex{},
+        mTable{DEFAULT_HASH_MB},
+        mSearch{mTable},
+        mWorker{},
+        mPosition{},
+        mHistory{},
+        mHasPosition{true},
+        mStateMutex{},
+        mStateChanged{},
+        mWaitForStop{false},
+        mStopReceived{false}
+    {
+        mPosition.ResetToStartPosition();
+        mSearch.SetIterationCallback([this](const SearchResult& result){ SendInfo(result); });
+    }
+
+    UciProtocol::~UciProtocol()
+    {
+        StopSearch();
+    }
+
+    /**
+     * @brief Read lines until "quit"; a closed input counts as "quit".
+     */
+    void UciProtocol::Run()
+    {
+        std::string line;
+        while(std::getline(mInput, line))
+        {
+            if(!HandleCommand(line))
+                break;
+        }
+        StopSearch();
+    }
+
+    /**
+     * @brief Dispatch on the first word; unknown commands are ignored as the protocol asks.
+     */
+    bool UciProtocol::HandleCommand(const std::string &line)
+    {
+        std::istringstream arguments{line};
+        std::string command;
+        arguments >> command;
+
+        if(command == "uci") HandleUci();
+        else if(command == "isready") Send("readyok");
+        else if(command == "setoption") HandleSetOption(arguments);
+        else if(command == "ucinewgame")
+        {
+            StopSearch();
+            mTable.Clear();
+        }
+        else if(command == "position") HandlePosition(arguments);
+        else if(command == "go") HandleGo(arguments);
+        else if(command == "stop") StopSearch();
+        else if(command == "ponderhit") HandlePonderHit();
+        else if(command == "quit") return false;
+        return true;
+    }
+
+    /**
+     * @brief Identify the engine and list the supported options.
+     */
+    void UciProtocol::HandleUci()
+    {
+        Send("id name Chess");
+        Send("id author SwarajZende0310");
+        Send("option name Hash type spin default " + std::to_string(DEFAULT_HASH_MB) + " min 1 max " + std::to_string(MAX_HASH_MB));
+        Send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+        Send("option name Ponder type check default false");
+        Send("uciok");
+    }
+
+    /**
+     * @brief Apply "Hash" and "Threads"; both only change while no search runs.
+     */
+    void UciProtocol::HandleSetOption(std::istringstream &arguments)
+    {
+        std::string token, name, value;
+        arguments >> token;
+        if(token != "name")
+            return;
+
+        // Option names may contain spaces
+        while(arguments >> token && token != "value")
+            name += (name.empty() ? "" : " ") + token;
+        std::getline(arguments >> std::ws, value);
+
+        if(name == "Hash")
+        {
+            StopSearch();
+            mTable.Resize(static_cast<size_t>(std::clamp(std::atoi(value.c_str()), 1, MAX_HASH_MB)));
+        }
+        else if(name == "Threads")
+        {
+            StopSearch();
+            mSearch.SetThreadCount(std::clamp(std::atoi(value.c_str()), 1, MAX_THREADS));
+        }
+    }
+
+    /**
+     * @brief Set up the root and replay the moves, recording keys for repetition detection.
+     *
+     * Moves are resolved against the legal moves; an illegal one ends the list.
+     * An invalid FEN is reported and leaves no position, so a following "go"
+     * cannot search a stale one.
+     */
+    void UciProtocol::HandlePosition(std::istringstream &arguments)
+    {
+        StopSearch();
+
+        std::string token, fen;
+        arguments >> token;
+        if(token == "startpos")
+        {
+            fen = Position::START_FEN;
+            arguments >> token;
+        }
+        else if(token == "fen")
+        {
+            while(arguments >> token && token != "moves")
+                fen += (fen.empty() ? "" : " ") + token;
+        }
+        else
+        {
+            return;
+        }
+
+        mHistory.clear();
+        mHasPosition = mPosition.SetFromFen(fen);
+        if(!mHasPosition)
+        {
+            Send("info string invalid fen " + fen);
+            return;
+        }
+        if(token != "moves")
+            return;
+
+        while(arguments >> token)
+        {
+            Move move = MoveGenerator::ParseMove(mPosition, token);
+            UndoRecord undo;
+            if(!move.IsValid())
+                break;
+            mHistory.push_back(mPosition.GetHash());
+            mPosition.MakeMove(move, undo);
+        }
+    }
+
+    /**
+     * @brief Parse the limits and hand them to a new worker.
+     */
+    void UciProtocol::HandleGo(std::istringstream &arguments)
+    {
+        StopSearch();
+        if(!mHasPosition)
+        {
+            Send("bestmove 0000");
+            return;
+        }
+
+        SearchLimits limits;
+        std::string token;
+        while(arguments >> token)
+        {
+            if(token == "depth") arguments >> limits.mMaxDepth;
+            else if(token == "movetime") arguments >> limits.mMoveTime;
+            else if(token == "wtime") arguments >> limits.mTimeLeft[0];
+            else if(token == "btime") arguments >> limits.mTimeLeft[1];
+            else if(token == "winc") arguments >> limits.mIncrement[0];
+            else if(token == "binc") arguments >> limits.mIncrement[1];
+            else if(token == "movestogo") arguments >> limits.mMovesToGo;
+            else if(token == "nodes") arguments >> limits.mMaxNodes;
+            else if(token == "infinite") limits.mInfinite = true;
+            else if(token == "ponder") limits.mPonder = true;
+        }
+        limits.mMaxDepth = std::clamp(limits.mMaxDepth, 1, MAX_PLY - 1);
+
+        {
+            std::lock_guard<std::mutex> lock{mStateMutex};
+            mWaitForStop = limits.mInfinite || limits.mPonder;
+            mStopReceived = false;
+        }
+        mSearch.ClearStop();
+        mWorker = std::thread{&UciProtocol::SearchWorker, this, limits};
+    }
+
+    /**
+     * @brief Turn the pondering search into a timed one, or release its held result.
+     */
+    void UciProtocol::HandlePonderHit()
+    {
+        mSearch.PonderHit();
+        {
+            std::lock_guard<std::mutex> lock{mStateMutex};
+            mWaitForStop = false;
+        }
+        mStateChanged.notify_all();
+    }
+
+    /**
+     * @brief Signal the search and the worker, then wait for the worker to send `bestmove`.
+     */
+    void UciProtocol::StopSearch()
+    {
+        mSearch.Stop();
+        {
+            std::lock_guard<std::mutex> lock{mStateMutex};
+            mStopReceived = true;
+        }
+        mStateChanged.notify_all();
+        if(mWorker.joinable())
+            mWorker.join();
+    }
+
+    /**
+     * @brief Search, then hold the result until the GUI allows a `bestmove`.
+     */
+    void UciProtocol::SearchWorker(SearchLimits limits)
+    {
+        SearchResult result = mSearch.Run(mPosition, limits, mHistory);
+
+        {
+            std::unique_lock<std::mutex> lock{mStateMutex};
+            mStateChanged.wait(lock, [this](){ return !mWaitForStop || mStopReceived; });
+        }
+
+        std::string line = "bestmove " + result.mBestMove.ToString();
+        if(result.mPrincipalVariation.size() > 1)
+            line += " ponder " + result.mPrincipalVariation[1].ToString();
+        Send(line);
+    }
+
+    /**
+     * @brief "info depth ... score ... nodes ... nps ... time ... hashfull ... pv ...".
+     */
+    void UciProtocol::SendInfo(const SearchResult &result)
+    {
+        uint64_t nodesPerSecond = result.mTime > 0 ? result.mNodes * 1000 / static_cast<uint64_t>(result.mTime) : 0;
+        std::string line = "info depth " + std::to_string(result.mDepth)
+            + " score " + FormatScore(result.mScore)
+            + " nodes " + std::to_string(result.mNodes)
+            + " nps " + std::to_string(nodesPerSecond)
+            + " time " + std::to_string(result.mTime)
+            + " hashfull " + std::to_string(mTable.GetHashFull());
+        if(!result.mPrincipalVariation.empty())
+        {
+            line += " pv";
+            for(Move move : result.mPrincipalVariation)
+                line += " " + move.ToString();
+        }
+        Send(line);
+    }
+
+    /**
+     * @brief Whole lines under the lock, so worker and reader output never interleave.
+     */
+    void UciProtocol::Send(const std::string &line)
+    {
+        std::lock_guard<std::mutex> lock{mOutputMutex};
+        mOutput << line << std::endl;
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file PonderHitTest.cpp
+ * @brief Sends "ponderhit" right behind "go ponder" and expects a timely "bestmove".
+ *
+ * The engine's reader thread sees the ponder hit before the search thread
+ * has started its clock, so a lost ponder hit leaves the engine pondering
+ * until "stop". Each round runs a fresh engine, since the race is at the
+ * start of a search.
+ *
+ * Usage: PonderHitTest <path to ChessEngineUci>
+ */
+#include<chrono>
+#include<csignal>
+#include<cstdio>
+#include<string>
+#include<poll.h>
+#include<sys/wait.h>
+#include<unistd.h>
+
+namespace
+{
+    constexpr int ROUNDS = 30;
+
+    /** @brief The move gets well under a second of a 2 s clock; anything near this is a lost ponder hit. */
+    constexpr std::chrono::milliseconds BESTMOVE_TIMEOUT{3000};
+
+    constexpr const char* COMMANDS = "position startpos\ngo ponder wtime 2000 btime 2000\nponderhit\n";
+
+    /**
+     * @brief Run one engine and wait for its "bestmove".
+     * @return False if the engine could not be started or no "bestmove" came in time
+     */
+    bool RunRound(const char* enginePath)
+    {
+        int toEngine[2], fromEngine[2];
+        if(pipe(toEngine) != 0 || pipe(fromEngine) != 0)
+            return false;
+
+        pid_t process = fork();
+        if(process == 0)
+        {
+            dup2(toEngine[0], STDIN_FILENO);
+            dup2(fromEngine[1], STDOUT_FILENO);
+            for(int descriptor : {toEngine[0], toEngine[1], fromEngine[0], fromEngine[1]})
+                close(descriptor);
+            execl(enginePath, enginePath, static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        close(toEngine[0]);
+        close(fromEngine[1]);
+        if(process < 0)
+            return false;
+
+        // All three commands in one write, so they reach the engine back to back
+        std::string commands = COMMANDS;
+        bool sent = write(toEngine[1], commands.data(), commands.size()) == static_cast<ssize_t>(commands.size());
+
+        std::string output;
+        bool bestMove = false;
+        auto deadline = std::chrono::steady_clock::now() + BESTMOVE_TIMEOUT;
+        while(sent && !bestMove)
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            pollfd input{fromEngine[0], POLLIN, 0};
+            if(left <= 0 || poll(&input, 1, static_cast<int>(left)) <= 0)
+                break;
+            char buffer[512];
+            ssize_t bytes = read(fromEngine[0], buffer, sizeof(buffer));
+            if(bytes <= 0)
+                break;
+            output.append(buffer, static_cast<size_t>(bytes));
+            bestMove = output.find("bestmove") != std::string::npos;
+        }
+
+        ssize_t written = write(toEngine[1], "quit\n", 5);
+        (void)written;
+        close(toEngine[1]);
+        close(fromEngine[0]);
+        if(!bestMove)
+            kill(process, SIGKILL);
+        waitpid(process, nullptr, 0);
+        return bestMove;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc != 2)
+    {
+        std::printf("Usage: PonderHitTest <path to ChessEngineUci>\n");
+        return 2;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int failures = 0;
+    for(int round = 0; round < ROUNDS; round++)
+    {
+        if(!RunRound(argv[1]))
+            failures++;
+    }
+
+    std::printf("%d rounds, %d without bestmove after an immediate ponderhit\n", ROUNDS, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -3,7 +3,10 @@
  * @brief Level for analysis board mode.
  *
  * Renders a free-play board with no timers and a minimal HUD containing
- * Home and Quit actions.
+ * Home and Quit actions. The engine analyses the position on the board in
+ * the background and streams its evaluation to the HUD. Setting the
+ * CHESS_UCI_ENGINE environment variable to an engine binary analyses with
+ * that engine instead.
  */
 #pragma once
 
@@ -13,6 +16,8 @@ namespace chess
 {
     class Application;
     class AnalysisBoardHUD;
+    class AnalysisWorker;
+    class UciEngine;
 
     /**
      * @brief Level for analysis board mode.
@@ -30,6 +35,9 @@ namespace chess
              */
             AnalysisBoardLevel(Application* owningApp);
 
+            /** @brief Stops the background analysis. */
+            ~AnalysisBoardLevel();
+
             /**
              * @brief Initialize gameplay state for analysis mode.
              *
@@ -41,11 +49,26 @@ namespace chess
             virtual void Render()override;
             virtual bool HandleEventInternal(const std::optional<sf::Event> & event)override;
 
+            /** @brief Keep ticking while an analyser runs, so its iterations show up as they arrive. */
+            virtual bool NeedsTick() const override;
+
         protected:
+            /**
+             * @brief Restart the analysis when the position changed and show its latest iteration.
+             */
+            virtual void Tick(float deltaTime)override;
 
         private:
             weak<AnalysisBoardHUD> mAnalysisBoardHUD;
 
+            unique<AnalysisWorker> mAnalysisWorker; ///< Infinite search on the board position
+            unique<UciEngine> mUciEngine;           ///< External engine, used instead of the worker if set
+            uint64_t mAnalysedHash;                 ///< Key of the position being analysed
+            bool mAnalysing;                        ///< The worker is running
+
+            /** @brief Stop the external engine or the built-in search. */
+            void StopAnalysis();
+
             void GoHome();
             void EndGame();
     };
@@ -0,0 +1,68 @@
+/**
+ * @file BotGameLevel.h
+ * @brief Level for playing against the built-in engine.
+ *
+ * The player has the white pieces; the engine answers as black. The
+ * search runs on a worker thread so the board keeps rendering while the
+ * engine thinks.
+ */
+#pragma once
+
+#include"framework/Stage.h"
+
+namespace chess
+{
+    class Application;
+    class AnalysisBoardHUD;
+    class SearchThread;
+
+    /**
+     * @brief Level for a game against the engine.
+     *
+     * Reuses the analysis HUD (Home/Quit and evaluation bar). Board input is
+     * only accepted on the player's turn.
+     */
+    class BotGameLevel : public Stage
+    {
+        public:
+            /**
+             * @brief Construct the bot game level.
+             * @param owningApp Pointer to the owning `Application` used to
+             *                  load worlds and access the render window.
+             */
+            BotGameLevel(Application* owningApp);
+
+            /** @brief Stops the engine if it is still thinking. */
+            ~BotGameLevel();
+
+            /**
+             * @brief Spawn the HUD and bind its button delegates.
+             */
+            virtual void BeginPlay()override;
+
+            virtual void Render()override;
+            virtual bool HandleEventInternal(const std::optional<sf::Event> & event)override;
+
+            /** @brief Keep ticking while the engine is (or is about to start) thinking. */
+            virtual bool NeedsTick() const override;
+
+        protected:
+            /**
+             * @brief Start the engine on its turn and play its move once found.
+             */
+            virtual void Tick(float deltaTime)override;
+
+        private:
+            weak<AnalysisBoardHUD> mBotGameHUD;
+
+            unique<SearchThread> mSearchThread; ///< Engine running off the game thread
+            bool mBotPlaysWhite;                ///< Side the engine plays
+            int64_t mBotMoveTime;               ///< Milliseconds the engine thinks per move
+
+            /** @brief True if the engine is the side to move. */
+            bool IsBotTurn() const;
+
+            void GoHome();
+            void EndGame();
+    };
+}
@@ -21,6 +21,8 @@ namespace chess
 
             void UpdateCurrentEvaluation(float eval);
 
+            void UpdateAnalysisLine(const std::string& line);
+
             Delegate<> onHomeButtonClicked;
             Delegate<> onQuitButtonClicked;
 
@@ -31,6 +33,7 @@ namespace chess
             Button mQuit;
 
             TextWidget mCurrEvaluation;
+            TextWidget mAnalysisLine;
 
             EvaluationBar mEvaluationBar;
 
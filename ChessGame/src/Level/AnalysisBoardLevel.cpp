@@ -1,21 +1,69 @@
 /**
  * @file AnalysisBoardLevel.cpp
- * @brief Implementation of the analysis board level: HUD wiring, rendering, and input forwarding.
+ * @brief Implementation of the analysis board level: HUD wiring, rendering, input forwarding and background analysis.
  */
 #include"Level/AnalysisBoardLevel.h"
 #include"Level/MainMenuLevel.h"
 #include"framework/Application.h"
+#include"framework/ChessState.h"
+#include"engine/AnalysisWorker.h"
+#include"engine/UciEngine.h"
 #include"widgets/AnalysisBoardHUD.h"
+#include<fmt/format.h>
+#include<cstdlib>
 
 namespace chess
 {
+    namespace
+    {
+        constexpr int MAX_SHOWN_VARIATION = 8;  ///< Moves of the principal variation shown on the HUD
+
+        /** @brief Pawns shown on the evaluation bar for a forced mate. */
+        constexpr float MATE_EVALUATION = 100.f;
+
+        /** @brief Environment variable naming an external UCI engine to analyse with. */
+        constexpr const char* UCI_ENGINE_VARIABLE = "CHESS_UCI_ENGINE";
+
+        /** @brief "depth 12  +0.35  e2e4 e7e5 ..." */
+        std::string FormatAnalysisLine(const AnalysisUpdate& update)
+        {
+            std::string line = update.IsMate()
+                ? fmt::format("depth {}  #{}", update.mDepth, update.GetMateInMoves())
+                : fmt::format("depth {}  {:+.2f}", update.mDepth, update.mScore / 100.f);
+
+            int shown = update.mVariationLength < MAX_SHOWN_VARIATION ? update.mVariationLength : MAX_SHOWN_VARIATION;
+            for(int i = 0; i < shown; i++)
+                line += (i == 0 ? "  " : " ") + update.mVariation[i].ToString();
+            return line;
+        }
+    }
+
     /**
      * @brief Construct the analysis level with the owning application context.
      */
     AnalysisBoardLevel::AnalysisBoardLevel(Application *owningApp)
-        :Stage{owningApp}
+        :Stage{owningApp},
+        mAnalysisBoardHUD{},
+        mAnalysisWorker{new AnalysisWorker{}},
+        mUciEngine{},
+        mAnalysedHash{0},
+        mAnalysing{false}
     {
-        
+        const char* enginePath = std::getenv(UCI_ENGINE_VARIABLE);
+        if(enginePath && *enginePath)
+        {
+            mUciEngine.reset(new UciEngine{});
+            if(!mUciEngine->Start(enginePath))
+            {
+                LOG("Could not start UCI engine %s, using the built-in engine", enginePath);
+                mUciEngine.reset();
+            }
+        }
+    }
+
+    AnalysisBoardLevel::~AnalysisBoardLevel()
+    {
+        StopAnalysis();
     }
 
     /**
@@ -50,18 +98,91 @@ namespace chess
     }
 
     /**
-     * @brief Navigate back to the main menu level.
+     * @brief Idle once the game is over; a new position starts the analysis again on the next input.
+     */
+    bool AnalysisBoardLevel::NeedsTick() const
+    {
+        return mAnalysing;
+    }
+
+    /**
+     * @brief Keep the analyser on the board position and forward its newest iteration.
+     *
+     * Only the latest queued update is shown; the earlier ones are shallower.
+     * Finished games are not analysed. If the external engine exits, the
+     * built-in one takes over.
+     */
+    void AnalysisBoardLevel::Tick(float deltaTime)
+    {
+        if(mUciEngine && !mUciEngine->IsRunning())
+        {
+            LOG("UCI engine stopped, using the built-in engine");
+            mUciEngine.reset();
+            mAnalysing = false;
+        }
+
+        const ChessState& state = ChessState::Get();
+        if(state.GetGameState() != GameState::Ongoing)
+        {
+            if(mAnalysing)
+            {
+                StopAnalysis();
+                mAnalysing = false;
+            }
+            return;
+        }
+
+        if(!mAnalysing || state.GetHash() != mAnalysedHash)
+        {
+            mAnalysedHash = state.GetHash();
+            mAnalysing = true;
+            if(mUciEngine)
+                mUciEngine->Analyse(state.GetStartPosition(), state.GetMovesPlayed());
+            else
+                mAnalysisWorker->Analyse(state.GetPosition(), state.GetHashHistory());
+        }
+
+        AnalysisUpdate update;
+        bool updated = false;
+        while(mUciEngine ? mUciEngine->PollUpdate(update) : mAnalysisWorker->PollUpdate(update))
+            updated = true;
+        if(!updated)
+            return;
+
+        float eval = update.mScore / 100.f;
+        if(update.IsMate())
+            eval = update.mScore > 0 ? MATE_EVALUATION : -MATE_EVALUATION;
+        mOnEvaluationUpdate.Broadcast(eval);
+
+        if(!mAnalysisBoardHUD.expired())
+            mAnalysisBoardHUD.lock()->UpdateAnalysisLine(FormatAnalysisLine(update));
+    }
+
+    /**
+     * @brief Stop whichever analyser is running.
+     */
+    void AnalysisBoardLevel::StopAnalysis()
+    {
+        mAnalysisWorker->Stop();
+        if(mUciEngine)
+            mUciEngine->Stop();
+    }
+
+    /**
+     * @brief Stop the analysis and navigate back to the main menu level.
      */
     void AnalysisBoardLevel::GoHome()
     {
+        StopAnalysis();
         GetApplication()->LoadWorld<MainMenuLevel>();
     }
 
     /**
-     * @brief Quit the application from the analysis HUD.
+     * @brief Stop the analysis and quit the application from the analysis HUD.
      */
     void AnalysisBoardLevel::EndGame()
     {
+        StopAnalysis();
         GetApplication()->QuitApplication();
     }
 }
\ No newline at end of file
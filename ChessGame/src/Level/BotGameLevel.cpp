@@ -0,0 +1,124 @@
+/**
+ * @file BotGameLevel.cpp
+ * @brief Implementation of the bot game level: engine turns, HUD wiring and input gating.
+ */
+#include"Level/BotGameLevel.h"
+#include"Level/MainMenuLevel.h"
+#include"framework/Application.h"
+#include"framework/ChessState.h"
+#include"engine/SearchThread.h"
+#include"widgets/AnalysisBoardHUD.h"
+
+namespace chess
+{
+    /**
+     * @brief Construct the level; the engine plays black with one second per move.
+     */
+    BotGameLevel::BotGameLevel(Application *owningApp)
+        :Stage{owningApp},
+        mBotGameHUD{},
+        mSearchThread{new SearchThread{}},
+        mBotPlaysWhite{false},
+        mBotMoveTime{1000}
+    {
+
+    }
+
+    BotGameLevel::~BotGameLevel()
+    {
+        mSearchThread->Stop();
+    }
+
+    /**
+     * @brief Spawn the HUD and bind its button delegates.
+     */
+    void BotGameLevel::BeginPlay()
+    {
+        mBotGameHUD = SpawnHUD<AnalysisBoardHUD>();
+
+        mBotGameHUD.lock()->onHomeButtonClicked.BindAction(GetWeakRef(), &BotGameLevel::GoHome);
+        mBotGameHUD.lock()->onQuitButtonClicked.BindAction(GetWeakRef(), &BotGameLevel::EndGame);
+        mOnEvaluationUpdate.BindAction(mBotGameHUD, &AnalysisBoardHUD::UpdateCurrentEvaluation);
+    }
+
+    /**
+     * @brief Render the board, pieces, and HUD each frame.
+     */
+    void BotGameLevel::Render()
+    {
+        RenderBoard();
+        RenderPieces();
+        RenderHUD(GetApplication()->GetWindow());
+    }
+
+    /**
+     * @brief Forward board events only while it is the player's turn.
+     *
+     * Once the game is over events go through again so the board handler
+     * reports the end state.
+     */
+    bool BotGameLevel::HandleEventInternal(const std::optional<sf::Event> & event)
+    {
+        if(IsBotTurn() && ChessState::Get().GetGameState() == GameState::Ongoing)
+            return false;
+        return HandleBoardEvent(event);
+    }
+
+    /**
+     * @brief On the engine's turn its result has to be polled every tick.
+     */
+    bool BotGameLevel::NeedsTick() const
+    {
+        return IsBotTurn() && ChessState::Get().GetGameState() == GameState::Ongoing;
+    }
+
+    /**
+     * @brief Kick off a search on the engine's turn and play the move it returns.
+     */
+    void BotGameLevel::Tick(float deltaTime)
+    {
+        if(!IsBotTurn() || ChessState::Get().GetGameState() != GameState::Ongoing)
+            return;
+
+        if(!mSearchThread->IsSearching())
+        {
+            SearchLimits limits;
+            limits.mMoveTime = mBotMoveTime;
+            mSearchThread->Start(ChessState::Get().GetPosition(), limits, ChessState::Get().GetHashHistory());
+            return;
+        }
+
+        SearchResult result;
+        if(mSearchThread->PollResult(result))
+        {
+            LOG("Bot played %s (depth %d, score %d, %llu nodes)", result.mBestMove.ToString().c_str(), result.mDepth, result.mScore, static_cast<unsigned long long>(result.mNodes));
+            PlayMove(result.mBestMove);
+        }
+    }
+
+    /**
+     * @brief Whether the side to move is the engine's.
+     */
+    bool BotGameLevel::IsBotTurn() const
+    {
+        return IsWhiteTurn() == mBotPlaysWhite;
+    }
+
+    /**
+     * @brief Stop the engine and navigate back to the main menu level.
+     */
+    void BotGameLevel::GoHome()
+    {
+        mSearchThread->Stop();
+        GetApplication()->LoadWorld<MainMenuLevel>();
+    }
+
+    /**
+     * @brief Stop the engine and quit the application.
+     */
+    void BotGameLevel::EndGame()
+    {
+        mSearchThread->Stop();
+        GetApplication()->QuitApplication();
+    }
+}
@@ -4,6 +4,7 @@
  */
 #include"Level/MainMenuLevel.h"
 #include"Level/AnalysisBoardLevel.h"
+#include"Level/BotGameLevel.h"
 #include"framework/Application.h"
 #include"widgets/MainMenuHUD.h"
 
@@ -50,11 +51,11 @@ namespace chess
     }
 
     /**
-     * @brief Placeholder: start bot game flow.
+     * @brief Navigate to the game against the engine.
      */
     void MainMenuLevel::PlayBot()
     {
-        LOG("Starting Bot Game Level");
+        GetApplication()->LoadWorld<BotGameLevel>();
     }
 
     /**
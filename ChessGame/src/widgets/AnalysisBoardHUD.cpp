@@ -3,6 +3,7 @@
  * @brief HUD for analysis board: draws Home/Quit buttons and handles clicks.
  */
 #include"widgets/AnalysisBoardHUD.h"
+#include<fmt/format.h>
 
 namespace chess
 {
@@ -13,6 +14,7 @@ namespace chess
         :mHome{"Home"},
         mQuit{"Quit"},
         mCurrEvaluation{"0.0"},
+        mAnalysisLine{""},
         mEvaluationBar{{50.f,800.f}}
     {
         
@@ -26,6 +28,7 @@ namespace chess
         mHome.NativeDraw(windowRef);
         mQuit.NativeDraw(windowRef);
         mCurrEvaluation.NativeDraw(windowRef);
+        mAnalysisLine.NativeDraw(windowRef);
         mEvaluationBar.NativeDraw(windowRef);
     }
 
@@ -63,6 +66,9 @@ namespace chess
         mCurrEvaluation.SetTextSize(30);
         mCurrEvaluation.SetWidgetLocation({400.f,0.f});
 
+        mAnalysisLine.SetTextSize(15);
+        mAnalysisLine.SetWidgetLocation({100.f,50.f});
+
         mEvaluationBar.SetWidgetLocation({940.f,100.f});
     }
 
@@ -91,4 +97,12 @@ namespace chess
         mCurrEvaluation.SetTextString(fmt::format("{:.1f}", eval));
         mEvaluationBar.UpdateCurrentEvaluation(eval);
     }
+
+    /**
+     * @brief Show the engine's depth, score and principal variation.
+     */
+    void AnalysisBoardHUD::UpdateAnalysisLine(const std::string &line)
+    {
+        mAnalysisLine.SetTextString(line);
+    }
 }
\ No newline at end of file
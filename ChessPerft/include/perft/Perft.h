@@ -0,0 +1,75 @@
+/**
+ * @file Perft.h
+ * @brief Move-path enumeration used to validate and benchmark move generation.
+ */
+#pragma once
+
+#include<atomic>
+#include<vector>
+#include"framework/MoveGenerator.h"
+#include"engine/TranspositionTable.h"
+#include"engine/WorkStealingPool.h"
+
+namespace chess
+{
+    /**
+     * @brief Leaf count below one root move.
+     */
+    struct PerftSplit
+    {
+        Move mMove;         ///< Root move
+        uint64_t mNodes;    ///< Leaf nodes reached after playing it
+    };
+
+    /**
+     * @brief Counts the leaf nodes of the legal move tree.
+     *
+     * The counts are compared against published values to catch bugs in
+     * move generation and make/unmake, and timed to measure their speed.
+     * With a transposition table, subtrees reached by transposition are
+     * counted once.
+     *
+     * The parallel variants hand the subtrees below the root moves (and
+     * optionally below the second ply) to a `WorkStealingPool` as separate
+     * tasks, each counting on its own copy of the position. A shared table
+     * is safe since its entries are lock-free.
+     */
+    class Perft
+    {
+        public:
+            /**
+             * @brief Count leaf nodes `depth` plies below `position`.
+             * @param position Position to search, restored before returning
+             * @param depth Plies to search
+             * @param table Optional cache of subtree counts
+             */
+            static uint64_t Run(Position& position, int depth, TranspositionTable* table = nullptr);
+
+            /**
+             * @brief Leaf counts per root move ("divide").
+             * @param position Position to search, restored before returning
+             * @param depth Plies to search, including the root move
+             * @param table Optional cache of subtree counts
+             */
+            static std::vector<PerftSplit> Divide(Position& position, int depth, TranspositionTable* table = nullptr);
+
+            /**
+             * @brief `Run` with the subtrees counted on a thread pool.
+             * @param splitDepth Plies whose moves become tasks: 1 splits at the root, 2 also below every root move
+             */
+            static uint64_t RunParallel(const Position& position, int depth, WorkStealingPool& pool,
+                                        TranspositionTable* table = nullptr, int splitDepth = 1);
+
+            /** @brief `Divide` with the subtrees counted on a thread pool (see `RunParallel`). */
+            static std::vector<PerftSplit> DivideParallel(const Position& position, int depth, WorkStealingPool& pool,
+                                                          TranspositionTable* table = nullptr, int splitDepth = 1);
+
+        private:
+            /**
+             * @brief Queue the count of a subtree, splitting it further while `splitDepth` allows.
+             * @param nodes Receives the leaf count once the pool is done
+             */
+            static void Split(WorkStealingPool& pool, const Position& position, int depth, int splitDepth,
+                              TranspositionTable* table, std::atomic<uint64_t>& nodes);
+    };
+}
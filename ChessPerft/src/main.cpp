@@ -0,0 +1,399 @@
+#include<algorithm>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<fstream>
+#include<memory>
+#include<sstream>
+#include<string>
+#include<thread>
+#include"framework/MappedFile.h"
+#include"framework/Pgn.h"
+#include"framework/San.h"
+#include"perft/Perft.h"
+
+namespace
+{
+    /** @brief Suite entries deeper than this are skipped unless --max-depth says otherwise. */
+    constexpr int MAX_SUITE_DEPTH = 64;
+
+    using Clock = std::chrono::steady_clock;
+
+    void PrintUsage()
+    {
+        std::printf("Usage:\n"
+                    "  ChessPerft [--fen \"<FEN>\"] [--depth N] [--divide] [--hash MB] [--threads N] [--split 1|2]\n"
+                    "  ChessPerft --suite <file.epd> [--max-depth N] [--hash MB] [--threads N] [--split 1|2]\n"
+                    "  ChessPerft --scaling [--fen \"<FEN>\"] [--depth N] [--hash MB] [--threads N] [--split 1|2]\n"
+                    "  ChessPerft --fen-roundtrip N\n"
+                    "  ChessPerft --pgn-suite <file.pgn>\n"
+                    "\n"
+                    "--hash caches subtree counts in a transposition table of that size.\n"
+                    "--threads counts subtrees in parallel; --split 2 also splits below the root moves.\n"
+                    "--scaling times 1, 2, 4, ... up to --threads threads and prints the speedup.\n"
+                    "--fen-roundtrip writes and reads back every position of N random games.\n"
+                    "--pgn-suite checks each game's [PlyCount], [EndFEN] and [Truncated] tags\n"
+                    "and that its moves survive SAN and PGN round trips.\n"
+                    "Suite lines look like: <FEN> ;D1 20 ;D2 400 ;D3 8902\n"
+                    "or <FEN> ;invalid for a position that must be rejected.\n");
+    }
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void PrintSpeed(uint64_t nodes, double seconds)
+    {
+        double nodesPerSecond = seconds > 0.0 ? nodes / seconds : 0.0;
+        std::printf("Nodes: %llu  Time: %.3f s  Speed: %.0f nodes/s\n",
+                    static_cast<unsigned long long>(nodes), seconds, nodesPerSecond);
+    }
+
+    /**
+     * @brief How the subtrees are counted: on the calling thread, or split across a pool.
+     */
+    struct Counter
+    {
+        chess::TranspositionTable* mTable;  ///< Optional subtree cache
+        chess::WorkStealingPool* mPool;     ///< Null to count on the calling thread
+        int mSplitDepth;                    ///< Plies split into tasks when there is a pool
+
+        uint64_t Run(chess::Position& position, int depth) const
+        {
+            if(mPool)
+                return chess::Perft::RunParallel(position, depth, *mPool, mTable, mSplitDepth);
+            return chess::Perft::Run(position, depth, mTable);
+        }
+
+        std::vector<chess::PerftSplit> Divide(chess::Position& position, int depth) const
+        {
+            if(mPool)
+                return chess::Perft::DivideParallel(position, depth, *mPool, mTable, mSplitDepth);
+            return chess::Perft::Divide(position, depth, mTable);
+        }
+    };
+
+    /**
+     * @brief Perft (or divide) one position and print the result.
+     */
+    int RunSingle(const std::string& fen, int depth, bool divide, const Counter& counter)
+    {
+        chess::Position position;
+        if(!position.SetFromFen(fen))
+        {
+            std::fprintf(stderr, "Invalid FEN: %s\n", fen.c_str());
+            return 2;
+        }
+
+        auto start = Clock::now();
+        uint64_t nodes = 0;
+        if(divide)
+        {
+            for(const chess::PerftSplit& split : counter.Divide(position, depth))
+            {
+                std::printf("%s: %llu\n", split.mMove.ToString().c_str(), static_cast<unsigned long long>(split.mNodes));
+                nodes += split.mNodes;
+            }
+            std::printf("\n");
+        }
+        else
+        {
+            nodes = counter.Run(position, depth);
+        }
+        PrintSpeed(nodes, SecondsSince(start));
+        return 0;
+    }
+
+    /**
+     * @brief Time the same perft with 1, 2, 4, ... threads and compare against one thread.
+     *
+     * Every run gets a fresh table, so no run profits from counts cached by
+     * the previous one.
+     */
+    int RunScaling(const std::string& fen, int depth, int maxThreads, int hashMB, int splitDepth)
+    {
+        chess::Position position;
+        if(!position.SetFromFen(fen))
+        {
+            std::fprintf(stderr, "Invalid FEN: %s\n", fen.c_str());
+            return 2;
+        }
+
+        // Build the attack tables now so the single-thread run does not pay for them
+        chess::Perft::Run(position, 1);
+
+        double baseSeconds = 0.0;
+        uint64_t baseNodes = 0;
+        for(int threads = 1; ; threads = std::min(threads * 2, maxThreads))
+        {
+            std::unique_ptr<chess::TranspositionTable> table;
+            if(hashMB > 0)
+                table = std::make_unique<chess::TranspositionTable>(static_cast<size_t>(hashMB));
+            chess::WorkStealingPool pool{threads};
+
+            auto start = Clock::now();
+            uint64_t nodes = chess::Perft::RunParallel(position, depth, pool, table.get(), splitDepth);
+            double seconds = SecondsSince(start);
+            if(threads == 1)
+            {
+                baseSeconds = seconds;
+                baseNodes = nodes;
+            }
+
+            std::printf("Threads: %3d  Nodes: %llu  Time: %.3f s  Speed: %.0f nodes/s  Speedup: %.2fx%s\n",
+                        threads, static_cast<unsigned long long>(nodes), seconds, seconds > 0.0 ? nodes / seconds : 0.0,
+                        seconds > 0.0 ? baseSeconds / seconds : 0.0, nodes == baseNodes ? "" : "  COUNT MISMATCH");
+            if(nodes != baseNodes)
+                return 1;
+            if(threads >= maxThreads)
+                break;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Play random legal games and check that every position survives a trip through FEN.
+     *
+     * The position read back must print the same FEN and have the same
+     * Zobrist key as the one reached by playing the moves. The games come
+     * from a fixed seed, so a failure reproduces.
+     * @return Non-zero if any position does not round-trip
+     */
+    int RunFenRoundTrip(int games)
+    {
+        constexpr int MAX_GAME_PLIES = 200;
+        uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+        auto nextRandom = [&state]()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * UINT64_C(0x2545F4914F6CDD1D);
+        };
+
+        int failures = 0, checks = 0;
+        for(int game = 0; game < games; game++)
+        {
+            chess::Position position;
+            position.ResetToStartPosition();
+            for(int ply = 0; ply < MAX_GAME_PLIES; ply++)
+            {
+                std::string fen = position.GetFen();
+                chess::Position loaded;
+                bool pass = loaded.SetFromFen(fen) && loaded.GetFen() == fen && loaded.GetHash() == position.GetHash();
+                checks++;
+                if(!pass)
+                {
+                    failures++;
+                    std::printf("FAIL  game %d ply %d: %s -> %s\n", game + 1, ply, fen.c_str(), loaded.GetFen().c_str());
+                    break;
+                }
+
+                chess::MoveList moves;
+                chess::MoveGenerator::GenerateLegalMoves(position, moves);
+                if(moves.Empty())
+                    break;
+                chess::UndoRecord undo;
+                position.MakeMove(moves[static_cast<int>(nextRandom() % static_cast<uint64_t>(moves.Size()))], undo);
+            }
+        }
+
+        std::printf("%d positions in %d games, %d failed\n", checks, games, failures);
+        return failures == 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Check one game of a PGN suite against its expectation tags and SAN/PGN round trips.
+     * @return Description of the first problem, empty if there is none
+     */
+    std::string CheckPgnGame(const chess::PgnGame& game)
+    {
+        if(game.mTruncated != !game.GetTag("Truncated").empty())
+            return game.mTruncated ? "unexpectedly truncated" : "should have been truncated";
+        std::string_view plyCount = game.GetTag("PlyCount");
+        if(!plyCount.empty() && std::to_string(game.mMoves.size()) != plyCount)
+            return "read " + std::to_string(game.mMoves.size()) + " plies";
+
+        // Every move must come back from its own SAN
+        chess::Position position = game.mStartPosition;
+        for(chess::Move move : game.mMoves)
+        {
+            std::string san = chess::San::ToString(position, move);
+            if(chess::San::Parse(position, san) != move)
+                return "SAN " + san + " does not parse back to " + move.ToString();
+            chess::UndoRecord undo;
+            position.MakeMove(move, undo);
+        }
+        std::string_view endFen = game.GetTag("EndFEN");
+        if(!endFen.empty() && position.GetFen() != endFen)
+            return "ends in " + position.GetFen();
+
+        // The written game must read back to the same moves
+        std::ostringstream written;
+        chess::PgnWriter::Write(written, game);
+        std::string text = written.str();
+        chess::PgnReader reader{text};
+        chess::PgnGame reread;
+        if(!reader.ReadGame(reread) || reread.mTruncated || reread.mMoves != game.mMoves
+            || reread.mResult != game.mResult || reread.mStartPosition.GetFen() != game.mStartPosition.GetFen())
+            return "does not read back from its PGN:\n" + text;
+        return {};
+    }
+
+    /**
+     * @brief Read every game of a PGN suite and check it with `CheckPgnGame`.
+     * @return Non-zero if any game fails
+     */
+    int RunPgnSuite(const std::string& path)
+    {
+        chess::MappedFile file;
+        if(!file.Open(path))
+        {
+            std::fprintf(stderr, "Cannot open PGN suite: %s\n", path.c_str());
+            return 2;
+        }
+
+        int failures = 0, games = 0;
+        chess::PgnReader reader{file.GetData()};
+        chess::PgnGame game;
+        while(reader.ReadGame(game))
+        {
+            games++;
+            std::string problem = CheckPgnGame(game);
+            std::string_view event = game.GetTag("Event");
+            if(!problem.empty()) failures++;
+            std::printf("%s  %.*s%s%s\n", problem.empty() ? "ok  " : "FAIL", static_cast<int>(event.size()), event.data(),
+                        problem.empty() ? "" : ": ", problem.c_str());
+        }
+
+        std::printf("\n%d games, %d failed\n", games, failures);
+        return failures == 0 && games > 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Check every position of an EPD perft suite.
+     * @return Non-zero if any count differs from the expected one
+     */
+    int RunSuite(const std::string& path, int maxDepth, const Counter& counter)
+    {
+        std::ifstream file{path};
+        if(!file)
+        {
+            std::fprintf(stderr, "Cannot open suite: %s\n", path.c_str());
+            return 2;
+        }
+
+        int failures = 0, checks = 0;
+        uint64_t totalNodes = 0;
+        auto suiteStart = Clock::now();
+
+        std::string line;
+        while(std::getline(file, line))
+        {
+            if(line.empty() || line[0] == '#')
+                continue;
+
+            size_t separator = line.find(';');
+            std::string fen = line.substr(0, separator);
+            fen.erase(fen.find_last_not_of(" \t") + 1);
+            // An ";invalid" entry is a position the parser has to refuse
+            bool expectInvalid = line.find(";invalid", separator) != std::string::npos;
+            chess::Position position;
+            bool loaded = position.SetFromFen(fen);
+            if(expectInvalid || !loaded)
+            {
+                bool pass = expectInvalid != loaded;
+                if(!pass) failures++;
+                checks++;
+                std::printf("%s  %s FEN: %s\n", pass ? "ok  " : "FAIL", loaded ? "accepted" : "rejected", fen.c_str());
+                continue;
+            }
+
+            while(separator != std::string::npos)
+            {
+                size_t next = line.find(';', separator + 1);
+                std::string field = line.substr(separator + 1, next == std::string::npos ? std::string::npos : next - separator - 1);
+                separator = next;
+
+                int depth = 0;
+                unsigned long long expected = 0;
+                if(std::sscanf(field.c_str(), " D%d %llu", &depth, &expected) != 2 || depth > maxDepth)
+                    continue;
+
+                auto start = Clock::now();
+                uint64_t nodes = counter.Run(position, depth);
+                double seconds = SecondsSince(start);
+                totalNodes += nodes;
+                checks++;
+
+                bool pass = nodes == expected;
+                if(!pass) failures++;
+                std::printf("%s  D%d %12llu (expected %12llu) %8.3f s  %s\n", pass ? "ok  " : "FAIL", depth,
+                            static_cast<unsigned long long>(nodes), expected, seconds, fen.c_str());
+            }
+        }
+
+        std::printf("\n%d checks, %d failed\n", checks, failures);
+        PrintSpeed(totalNodes, SecondsSince(suiteStart));
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string fen = chess::Position::START_FEN;
+    std::string suite;
+    std::string pgnSuite;
+    int depth = 5;
+    int maxDepth = MAX_SUITE_DEPTH;
+    int hashMB = 0;
+    int threads = 1;
+    int splitDepth = 1;
+    bool divide = false;
+    bool scaling = false;
+    int roundTripGames = 0;
+
+    for(int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(argument == "--fen" && hasValue) fen = argv[++i];
+        else if(argument == "--depth" && hasValue) depth = std::atoi(argv[++i]);
+        else if(argument == "--divide") divide = true;
+        else if(argument == "--suite" && hasValue) suite = argv[++i];
+        else if(argument == "--pgn-suite" && hasValue) pgnSuite = argv[++i];
+        else if(argument == "--max-depth" && hasValue) maxDepth = std::atoi(argv[++i]);
+        else if(argument == "--hash" && hasValue) hashMB = std::atoi(argv[++i]);
+        else if(argument == "--threads" && hasValue) threads = std::atoi(argv[++i]);
+        else if(argument == "--split" && hasValue) splitDepth = std::clamp(std::atoi(argv[++i]), 1, 2);
+        else if(argument == "--scaling") scaling = true;
+        else if(argument == "--fen-roundtrip" && hasValue) roundTripGames = std::max(1, std::atoi(argv[++i]));
+        else
+        {
+            PrintUsage();
+            return argument == "--help" ? 0 : 2;
+        }
+    }
+
+    if(roundTripGames > 0)
+        return RunFenRoundTrip(roundTripGames);
+    if(!pgnSuite.empty())
+        return RunPgnSuite(pgnSuite);
+    if(threads <= 0)
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    if(scaling)
+        return RunScaling(fen, depth, threads, hashMB, splitDepth);
+
+    std::unique_ptr<chess::TranspositionTable> table;
+    if(hashMB > 0)
+        table = std::make_unique<chess::TranspositionTable>(static_cast<size_t>(hashMB));
+    std::unique_ptr<chess::WorkStealingPool> pool;
+    if(threads > 1)
+        pool = std::make_unique<chess::WorkStealingPool>(threads);
+
+    Counter counter{table.get(), pool.get(), splitDepth};
+    if(!suite.empty())
+        return RunSuite(suite, maxDepth, counter);
+    return RunSingle(fen, depth, divide, counter);
+}
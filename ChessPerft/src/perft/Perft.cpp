@@ -0,0 +1,137 @@
+/**
+ * @file Perft.cpp
+ * @brief Perft and divide.
+ */
+#include"perft/Perft.h"
+
+namespace chess
+{
+    /**
+     * @brief Recursive perft with bulk counting at the last ply.
+     *
+     * At depth 1 the number of legal moves is the leaf count, so those moves
+     * are never played. Bulk-counted nodes are cheaper to regenerate than to
+     * look up, so only deeper subtrees go through the table.
+     */
+    uint64_t Perft::Run(Position &position, int depth, TranspositionTable* table)
+    {
+        if(depth <= 0)
+            return 1;
+
+        MoveList moves;
+        MoveGenerator::GenerateLegalMoves(position, moves);
+        if(depth == 1)
+            return static_cast<uint64_t>(moves.Size());
+
+        uint64_t nodes = 0;
+        if(table && table->ProbePerft(position.GetHash(), depth, nodes))
+            return nodes;
+
+        UndoRecord undo;
+        for(Move move : moves)
+        {
+            position.MakeMove(move, undo);
+            nodes += Run(position, depth - 1, table);
+            position.UnmakeMove(undo);
+        }
+
+        if(table)
+            table->StorePerft(position.GetHash(), depth, nodes);
+        return nodes;
+    }
+
+    /**
+     * @brief Run perft below every root move separately.
+     */
+    std::vector<PerftSplit> Perft::Divide(Position &position, int depth, TranspositionTable* table)
+    {
+        std::vector<PerftSplit> splits;
+        if(depth <= 0)
+            return splits;
+
+        MoveList moves;
+        MoveGenerator::GenerateLegalMoves(position, moves);
+
+        UndoRecord undo;
+        for(Move move : moves)
+        {
+            position.MakeMove(move, undo);
+            splits.push_back(PerftSplit{move, Run(position, depth - 1, table)});
+            position.UnmakeMove(undo);
+        }
+        return splits;
+    }
+
+    /**
+     * @brief Sum of the per-root-move counts; a depth of 1 is not worth a task.
+     */
+    uint64_t Perft::RunParallel(const Position &position, int depth, WorkStealingPool &pool, TranspositionTable* table, int splitDepth)
+    {
+        if(depth <= 1)
+        {
+            Position copy = position;
+            return Run(copy, depth, table);
+        }
+
+        uint64_t nodes = 0;
+        for(const PerftSplit& split : DivideParallel(position, depth, pool, table, splitDepth))
+            nodes += split.mNodes;
+        return nodes;
+    }
+
+    /**
+     * @brief One counter per root move; every task adds its leaves to the counter of its root move.
+     */
+    std::vector<PerftSplit> Perft::DivideParallel(const Position &position, int depth, WorkStealingPool &pool, TranspositionTable* table, int splitDepth)
+    {
+        std::vector<PerftSplit> splits;
+        if(depth <= 0)
+            return splits;
+
+        MoveList moves;
+        MoveGenerator::GenerateLegalMoves(position, moves);
+        std::vector<std::atomic<uint64_t>> counts(static_cast<size_t>(moves.Size()));
+
+        for(int i = 0; i < moves.Size(); i++)
+        {
+            Position child = position;
+            UndoRecord undo;
+            child.MakeMove(moves[i], undo);
+            Split(pool, child, depth - 1, splitDepth, table, counts[i]);
+        }
+        pool.Wait();
+
+        for(int i = 0; i < moves.Size(); i++)
+            splits.push_back(PerftSplit{moves[i], counts[i].load(std::memory_order_relaxed)});
+        return splits;
+    }
+
+    /**
+     * @brief The task copies the position, so the caller's copy may go away before it runs.
+     *
+     * Tasks queued from a worker land on its own deque, where idle workers
+     * steal them.
+     */
+    void Perft::Split(WorkStealingPool &pool, const Position &position, int depth, int splitDepth, TranspositionTable* table, std::atomic<uint64_t> &nodes)
+    {
+        pool.Submit([&pool, position, depth, splitDepth, table, &nodes](int)
+        {
+            Position local = position;
+            if(splitDepth <= 1 || depth <= 2)
+            {
+                nodes.fetch_add(Run(local, depth, table), std::memory_order_relaxed);
+                return;
+            }
+
+            MoveList moves;
+            MoveGenerator::GenerateLegalMoves(local, moves);
+            UndoRecord undo;
+            for(Move move : moves)
+            {
+                local.MakeMove(move, undo);
+                Split(pool, local, depth - 1, splitDepth - 1, table, nodes);
+                local.UnmakeMove(undo);
+            }
+        });
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file AttackTable.h
+ * @brief Precomputed attack bitboards for every piece type.
+ */
+#pragma once
+
+#include"framework/Bitboard.h"
+
+#if defined(__BMI2__)
+#include<immintrin.h>
+#endif
+
+namespace chess
+{
+    /**
+     * @brief Singleton holding precomputed attack tables.
+     *
+     * Knight, king and pawn attacks are plain per-square lookups. Sliding
+     * pieces use magic bitboards (or PEXT when compiled with BMI2): the
+     * relevant blockers are hashed into a per-square slice of a shared table
+     * that was filled once at construction, so every query is O(1).
+     */
+    class AttackTable
+    {
+        public:
+            /** @brief Get the global singleton instance. */
+            static AttackTable& Get();
+
+            /** @brief Squares attacked by a pawn of the given color standing on `square`. */
+            uint64_t GetPawnAttacks(int square, bool white) const { return mPawnAttacks[white ? 0 : 1][square]; }
+            /** @brief Squares attacked by a knight on `square`. */
+            uint64_t GetKnightAttacks(int square) const { return mKnightAttacks[square]; }
+            /** @brief Squares attacked by a king on `square`. */
+            uint64_t GetKingAttacks(int square) const { return mKingAttacks[square]; }
+
+            /** @brief Diagonal attacks from `square` given the board occupancy. */
+            uint64_t GetBishopAttacks(int square, uint64_t occupancy) const { return mBishopMagics[square].Lookup(occupancy); }
+            /** @brief Orthogonal attacks from `square` given the board occupancy. */
+            uint64_t GetRookAttacks(int square, uint64_t occupancy) const { return mRookMagics[square].Lookup(occupancy); }
+            /** @brief Union of bishop and rook attacks from `square`. */
+            uint64_t GetQueenAttacks(int square, uint64_t occupancy) const { return GetBishopAttacks(square, occupancy) | GetRookAttacks(square, occupancy); }
+
+            /** @brief Squares strictly between two squares on a common rank, file or diagonal, else 0. */
+            uint64_t GetBetween(int from, int to) const { return mBetween[from][to]; }
+            /** @brief Whole board line through two aligned squares (both included), else 0. */
+            uint64_t GetLine(int from, int to) const { return mLine[from][to]; }
+
+        protected:
+            /** @brief Construct hidden for singleton pattern; builds all tables. */
+            AttackTable();
+
+        private:
+            /** @brief Ray directions; the first four run towards higher square indices. */
+            enum Direction
+            {
+                North = 0,
+                West,
+                NorthEast,
+                NorthWest,
+                South,
+                East,
+                SouthEast,
+                SouthWest,
+                DirectionCount
+            };
+
+            /**
+             * @brief Per-square magic entry for one sliding piece type.
+             */
+            struct Magic
+            {
+                uint64_t mask;      ///< Relevant blocker squares (board edges excluded)
+                uint64_t magic;     ///< Multiplier hashing blockers to an index
+                uint64_t* attacks;  ///< Start of this square's slice in the shared table
+                unsigned shift;     ///< 64 minus the number of relevant bits
+
+                /** @brief Index of an occupancy inside this square's slice. */
+                unsigned Index(uint64_t occupancy) const
+                {
+                #if defined(__BMI2__)
+                    return static_cast<unsigned>(_pext_u64(occupancy, mask));
+                #else
+                    return static_cast<unsigned>(((occupancy & mask) * magic) >> shift);
+                #endif
+                }
+
+                /** @brief Attacks for an occupancy. */
+                uint64_t Lookup(uint64_t occupancy) const { return attacks[Index(occupancy)]; }
+            };
+
+            /** @brief Fill pawn, knight and king tables. */
+            void InitLeaperAttacks();
+            /** @brief Fill the per-direction ray masks. */
+            void InitRays();
+            /** @brief Fill the between and line tables from the rays. */
+            void InitLines();
+            /**
+             * @brief Find magics and fill the shared attack table for one slider type.
+             * @param magics Per-square magic entries to fill.
+             * @param table Shared attack table the entries point into.
+             * @param directions Ray directions of the slider.
+             */
+            void InitMagics(Magic* magics, uint64_t* table, const Direction* directions);
+
+            /** @brief Attacks along one ray, stopping at (and including) the first blocker. */
+            uint64_t GetRayAttacks(int square, uint64_t occupancy, Direction direction) const;
+            /** @brief Ray-walking attacks used as reference while building the magic tables. */
+            uint64_t GetSlidingAttacks(int square, uint64_t occupancy, const Direction* directions) const;
+
+            /** @brief Bitboard of the squares reached by offsets from a square, skipping off-board ones. */
+            static uint64_t StepAttacks(int square, const int* offsetRank, const int* offsetFile, int count);
+            /** @brief Advance the magic-search random generator. */
+            static uint64_t NextRandom(uint64_t& state);
+
+            static unique<AttackTable> mAttackTable; ///< Singleton instance
+
+            static constexpr int ROOK_TABLE_SIZE = 102400;  ///< Sum of 2^bits over all rook squares
+            static constexpr int BISHOP_TABLE_SIZE = 5248;  ///< Sum of 2^bits over all bishop squares
+
+            uint64_t mPawnAttacks[2][SQUARE_COUNT];         ///< [white, black] pawn captures
+            uint64_t mKnightAttacks[SQUARE_COUNT];          ///< Knight jumps
+            uint64_t mKingAttacks[SQUARE_COUNT];            ///< King steps
+            uint64_t mRays[DirectionCount][SQUARE_COUNT];   ///< Empty-board rays per direction
+            uint64_t mBetween[SQUARE_COUNT][SQUARE_COUNT];  ///< Squares strictly between two aligned squares
+            uint64_t mLine[SQUARE_COUNT][SQUARE_COUNT];     ///< Full line through two aligned squares
+
+            Magic mRookMagics[SQUARE_COUNT];                ///< Rook magic entries
+            Magic mBishopMagics[SQUARE_COUNT];              ///< Bishop magic entries
+            List<uint64_t> mRookTable;                      ///< Shared rook attack table
+            List<uint64_t> mBishopTable;                    ///< Shared bishop attack table
+    };
+}
@@ -0,0 +1,111 @@
+/**
+ * @file Bitboard.h
+ * @brief Square indexing and bit manipulation helpers for 64-bit bitboards.
+ *
+ * Squares follow the layout `ChessState` has always used: rank 1 lives in the
+ * lowest byte and, inside a rank, file 'a' is the most significant bit
+ * (square = 8 * (rank - 1) + ('h' - file)).
+ */
+#pragma once
+
+#include"framework/Core.h"
+
+#if defined(_MSC_VER)
+#include<intrin.h>
+#endif
+
+namespace chess
+{
+    /** @brief Number of squares on the board. */
+    constexpr int SQUARE_COUNT = 64;
+
+    /** @brief Invalid square index. */
+    constexpr int NO_SQUARE = -1;
+
+    constexpr uint64_t FILE_A_MASK = UINT64_C(0x8080808080808080); ///< All squares on file 'a'
+    constexpr uint64_t FILE_H_MASK = UINT64_C(0x0101010101010101); ///< All squares on file 'h'
+    constexpr uint64_t RANK_1_MASK = UINT64_C(0x00000000000000FF); ///< All squares on rank 1
+    constexpr uint64_t RANK_8_MASK = UINT64_C(0xFF00000000000000); ///< All squares on rank 8
+
+    /**
+     * @brief Square index of a rank/file pair.
+     * @param rank Rank (1..8)
+     * @param file File ('a'..'h')
+     */
+    inline int ToSquare(int rank, char file)
+    {
+        return 8 * (rank - 1) + ('h' - file);
+    }
+
+    /** @brief Square index of a (valid) coordinate. */
+    inline int ToSquare(const ChessCoordinate& coordinate)
+    {
+        return ToSquare(coordinate.rank, coordinate.file);
+    }
+
+    /** @brief Coordinate of a square index (0..63). */
+    inline ChessCoordinate ToChessCoordinate(int square)
+    {
+        return ChessCoordinate{square / 8 + 1, static_cast<char>('h' - square % 8)};
+    }
+
+    /** @brief Rank index (0..7) of a square. */
+    inline int RankOf(int square)
+    {
+        return square >> 3;
+    }
+
+    /** @brief File index (0 for 'a' .. 7 for 'h') of a square. */
+    inline int FileOf(int square)
+    {
+        return 7 - (square & 7);
+    }
+
+    /** @brief Single-bit mask for a square. */
+    inline uint64_t SquareBit(int square)
+    {
+        return UINT64_C(1) << square;
+    }
+
+    /** @brief Number of set bits. */
+    inline int PopCount(uint64_t bitboard)
+    {
+    #if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(bitboard));
+    #else
+        return __builtin_popcountll(bitboard);
+    #endif
+    }
+
+    /** @brief Index of the lowest set bit (bitboard must be non-zero). */
+    inline int LowestSquare(uint64_t bitboard)
+    {
+    #if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bitboard);
+        return static_cast<int>(index);
+    #else
+        return __builtin_ctzll(bitboard);
+    #endif
+    }
+
+    /** @brief Index of the highest set bit (bitboard must be non-zero). */
+    inline int HighestSquare(uint64_t bitboard)
+    {
+    #if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, bitboard);
+        return static_cast<int>(index);
+    #else
+        return 63 - __builtin_clzll(bitboard);
+    #endif
+    }
+
+    /** @brief Remove and return the lowest set bit's square (bitboard must be non-zero). */
+    inline int PopLowestSquare(uint64_t& bitboard)
+    {
+        int square = LowestSquare(bitboard);
+        bitboard &= bitboard - 1;
+        return square;
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file ChessState.h
+ * @brief Bitboard-based chess state tracking and queries.
+ */
+#pragma once
+
+#include"framework/MoveGenerator.h"
+#include"framework/Evaluation.h"
+
+namespace chess
+{
+    /**
+     * @brief Singleton that owns the position of the game being played.
+     *
+     * Thin wrapper over a `Position` that adds move history/undo and caches
+     * the attacked squares for the UI. Anything that only needs to look at
+     * the board (legality checks, analysis) should copy `GetPosition()`
+     * instead of playing moves here.
+     *
+     * The legal moves, a material signature, the evaluation sums and a count
+     * of every position reached are kept up to date as moves are played and
+     * undone, so the result of the game and its static evaluation are known
+     * after each move without rescanning the board or the history.
+     */
+    class ChessState
+    {
+        public:
+            /** @brief Get the global singleton instance. */
+            static ChessState& Get();
+
+            /** @brief Reset to the standard initial chess position. */
+            void ResetToStartPosition();
+
+            /**
+             * @brief Start a game from a FEN position, clearing the move history.
+             * @return False (keeping the current game) if the FEN is malformed
+             */
+            bool SetFromFen(std::string_view fen);
+
+            /** @brief FEN of the current position. */
+            std::string GetFen() const { return mPosition.GetFen(); }
+            
+            /** @brief Get all coordinates where a given piece currently exists. */
+            List<ChessCoordinate> GetPiecePosiiton(PieceType piece);
+
+            /**
+             * @brief Play a move from start to end and append it to the history.
+             * @param piece Piece identifier
+             * @param start Start coordinate
+             * @param end End coordinate
+             * @param promotion Piece a pawn reaching the last rank becomes (queen if 'invalid')
+             */
+            void SetPiecePosition(PieceType piece, ChessCoordinate& start, ChessCoordinate& end, PieceType promotion = PieceType::invalid);
+
+            /** @brief Undo the last logged move if available. */
+            bool UndoLastMove();
+
+            /** @brief Get the piece occupying a coordinate or 'invalid'. */
+            PieceType GetPieceOnChessCoordinate(ChessCoordinate coordinate);
+
+            /** @brief Remove a specific piece at the position. */
+            void RemovePiece(PieceType piece,ChessCoordinate& position);
+
+            /** @brief Bitboard of squares attacked by white pieces. */
+            uint64_t GetWhiteAttacks(){ return mWhiteAttacks; }
+            /** @brief Bitboard of squares attacked by black pieces. */
+            uint64_t GetBlackAttacks(){ return mBlackAttacks; }
+
+            /** @brief Bitboard of a single piece type. */
+            uint64_t GetPieceBitboard(PieceType piece){ return mPosition.GetPieceBitboard(piece); }
+
+            /** @brief Bitboard of every occupied square. */
+            uint64_t GetOccupancy(){ return mPosition.GetOccupancy(); }
+
+            /** @brief Bitboard of the squares occupied by one side. */
+            uint64_t GetOccupancy(bool white){ return mPosition.GetOccupancy(white); }
+
+            /** @brief True if the side-to-query's king is in check. */
+            bool KingInCheck(bool white);
+
+            /** @brief Place a new piece onto the board. */
+            void SpawnPiece(PieceType piece, ChessCoordinate& position);
+
+            /** @brief Get the last move played, or the null move if none. */
+            Move GetLastPlayedMove();
+
+            /** @brief Count of specific piece type currently on the board. */
+            int GetPieceCount(PieceType piece);
+
+            /** @brief Half-move clock (for 50-move rule). */
+            int GetMovesWithoutCapture();
+
+            /** @brief Zobrist key of the current position. */
+            uint64_t GetHash() const { return mPosition.GetHash(); }
+
+            /** @brief True if the current position occurred twice before with the same side to move. */
+            bool IsThreefoldRepetition() const;
+
+            /** @brief Number of times the current position has occurred in this game. */
+            int GetRepetitionCount() const;
+
+            /**
+             * @brief Piece counts packed four bits per piece, indexed by `Position::PieceIndex`.
+             *
+             * Equal signatures mean equal material, whatever the squares.
+             */
+            uint64_t GetMaterialSignature() const { return mMaterialSignature; }
+
+            /** @brief Tapered material and piece-square evaluation in centipawns, positive when white is better. */
+            int GetEvaluation() const { return Evaluation::Taper(mEvaluation); }
+
+            /** @brief Number of legal moves of the side to move. */
+            int GetLegalMoveCount() const { return mLegalMoves.Size(); }
+
+            /** @brief Zobrist keys of the positions before each played move, oldest first (for search repetition checks). */
+            List<uint64_t> GetHashHistory() const;
+
+            /** @brief Moves played since `GetStartPosition`, oldest first (for UCI "position ... moves ..."). */
+            List<Move> GetMovesPlayed() const;
+
+            /** @brief Legal moves of the side to move, cached per position. */
+            const MoveList& GetLegalMoves() const { return mLegalMoves; }
+
+            /** @brief Whether `move` is legal for the side to move. */
+            bool IsLegalMove(Move move) const { return mLegalMoves.Contains(move); }
+
+            /**
+             * @brief Result of the game for the side to move.
+             *
+             * Checkmate, stalemate, the 50-move rule, threefold repetition
+             * and insufficient material are detected; otherwise the game
+             * is 'Ongoing'. Decided once per move, so this is a plain read.
+             */
+            GameState GetGameState() const { return mGameState; }
+
+            /** @brief The current position; copy it to analyse without side effects. */
+            const Position& GetPosition() const { return mPosition; }
+
+            /** @brief Position the game started from; `GetMovesPlayed` leads from it to `GetPosition`. */
+            const Position& GetStartPosition() const { return mStartPosition; }
+
+        protected:
+            /** @brief Construct hidden for singleton pattern. */
+            ChessState();
+
+        private:
+            /** @brief Recompute attacked squares for both sides, the legal moves and the game state. */
+            void UpdateAttackedSquare();
+
+            /** @brief Decide the game state from the cached move list, clock, material and repetitions. */
+            GameState ComputeGameState() const;
+
+            /** @brief Adjust the material signature and evaluation for one piece added (+1) or removed (-1). */
+            void UpdatePiece(PieceType piece, int square, int delta);
+
+            /**
+             * @brief Apply (+1) or revert (-1) the piece changes of a played move.
+             * @param move Undo record of the move
+             * @param delta +1 after playing the move, -1 before taking it back
+             */
+            void UpdateMove(const UndoRecord& move, int delta);
+
+            /** @brief Count one more (+1) or one fewer (-1) occurrence of the current position. */
+            void UpdateRepetitionCount(int delta);
+
+            /** @brief Count of one piece type stored in a material signature. */
+            static int GetMaterialCount(uint64_t signature, PieceType piece);
+
+            /** @brief Signature of the pieces currently on the board. */
+            static uint64_t ComputeMaterialSignature(const Position& position);
+
+            /** @brief Neither side can possibly mate with this material. */
+            static bool IsInsufficientMaterial(uint64_t signature);
+
+            static unique<ChessState> mChessState; ///< Singleton instance
+
+            Position mPosition;      ///< Current position
+            Position mStartPosition; ///< Position before the first logged move
+
+            uint64_t mWhiteAttacks;  ///< Squares attacked by white
+            uint64_t mBlackAttacks;  ///< Squares attacked by black
+            MoveList mLegalMoves;    ///< Legal moves of the side to move
+
+            List<UndoRecord> mMovesPlayed; ///< Move history
+
+            uint64_t mMaterialSignature;                     ///< Packed piece counts
+            EvaluationScore mEvaluation;                     ///< Evaluation sums of the pieces on the board
+            std::unordered_map<uint64_t, int> mPositionCounts; ///< Occurrences of each Zobrist key reached in this game
+            GameState mGameState;                            ///< Result as of the current position
+    };
+}
\ No newline at end of file
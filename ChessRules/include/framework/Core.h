@@ -4,7 +4,7 @@
  *
  * Provides STL alias templates, logging macro, chess piece identifiers,
  * game state constants, and lightweight data types like `ChessCoordinate`
- * and `PlayedMove` used across the engine.
+ * used across the engine.
  */
 #pragma once
 
@@ -17,7 +17,7 @@
 #include<unordered_set>
 #include<utility>
 #include<cmath>
-#include <fmt/format.h>
+#include<cstdint>
 
 namespace chess
 {
@@ -73,7 +73,7 @@ namespace chess
     * 
     * This enum is used to identify different PieceTypes.
     */
-    enum class PieceType
+    enum class PieceType : int8_t
     {
         invalid = 0,
         whitePawn = 1,
@@ -179,54 +179,4 @@ namespace chess
                 return std::hash<int>()(coordinate.rank) ^ std::hash<char>()(coordinate.file);
             }
     };
-
-    /**
-     * @brief Record of a move that was played, including captures and castling.
-     */
-    struct PlayedMove
-    {
-        public:
-        /**
-         * @brief Construct an empty move (no piece, invalid coordinates).
-         */
-        PlayedMove()
-            :mPiece{PieceType::invalid},
-            mStartCoordinate{},
-            mEndCoordinate{},
-            mCapturedPiece{PieceType::invalid},
-            mCapturedPieceCoordinate{},
-            mCastling{CastlingState::NoCastling}
-        {
-
-        }
-
-        /**
-         * @brief Construct a fully specified move record.
-         * @param piece Piece identifier
-         * @param start Start coordinate
-         * @param end End coordinate
-         * @param capturedPiece Captured piece identifier (or 'invalid')
-         * @param capturedCoordinate Coordinate of captured piece
-         * @param castling CastlingState flag (NoCastling/KingSide/QueenSide)
-         */
-        PlayedMove(PieceType piece, ChessCoordinate start, ChessCoordinate end, PieceType capturedPiece, ChessCoordinate capturedCoordinate,CastlingState castling)
-            :mPiece{piece},
-            mStartCoordinate{start.rank,start.file},
-            mEndCoordinate{end.rank,end.file},
-            mCapturedPiece{capturedPiece},
-            mCapturedPieceCoordinate{capturedCoordinate.rank,capturedCoordinate.file},
-            mCastling{castling}
-            {
-
-            }
-        
-        PieceType mPiece;                ///< Piece that moved
-        ChessCoordinate mStartCoordinate;///< Starting coordinate
-        ChessCoordinate mEndCoordinate;  ///< Ending coordinate
-
-        PieceType mCapturedPiece;                 ///< Captured piece ('invalid' if none)
-        ChessCoordinate mCapturedPieceCoordinate; ///< Coordinate of captured piece
-
-        CastlingState mCastling;                   ///< CastlingState flag
-    };
 }
\ No newline at end of file
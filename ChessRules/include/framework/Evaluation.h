@@ -0,0 +1,65 @@
+/**
+ * @file Evaluation.h
+ * @brief Static evaluation: material plus tapered piece-square tables.
+ */
+#pragma once
+
+#include"framework/Position.h"
+
+namespace chess
+{
+    /**
+     * @brief Running sums the evaluation is built from.
+     *
+     * Every piece adds its middlegame and endgame value and its game phase
+     * weight, so the sums can be updated by delta as pieces move instead of
+     * being recomputed.
+     */
+    struct EvaluationScore
+    {
+        int mMiddlegame = 0;    ///< White-relative middlegame score
+        int mEndgame = 0;       ///< White-relative endgame score
+        int mPhase = 0;         ///< Non-pawn material weight, `Evaluation::MAX_PHASE` at the start
+
+        bool operator==(const EvaluationScore& other) const
+        {
+            return mMiddlegame == other.mMiddlegame && mEndgame == other.mEndgame && mPhase == other.mPhase;
+        }
+    };
+
+    /**
+     * @brief Static position evaluation in centipawns.
+     *
+     * Scores are from white's point of view: positive means white is better.
+     * The middlegame and endgame scores are blended by how much non-pawn
+     * material is left, so e.g. the king is pushed to the centre once the
+     * queens are gone.
+     */
+    class Evaluation
+    {
+        public:
+            /** @brief Phase weight of the starting material (knight and bishop 1, rook 2, queen 4). */
+            static constexpr int MAX_PHASE = 24;
+
+            /** @brief Tapered material plus piece-square score of a position. */
+            static int Evaluate(const Position& position);
+
+            /** @brief Accumulate the score of every piece of a position from scratch. */
+            static EvaluationScore ComputeScore(const Position& position);
+
+            /**
+             * @brief Add (`delta` = 1) or take away (`delta` = -1) one piece on a square.
+             * @param score Sums to update
+             * @param piece Piece of either colour; 'invalid' is ignored
+             * @param square Square of the piece
+             * @param delta +1 or -1
+             */
+            static void UpdateScore(EvaluationScore& score, PieceType piece, int square, int delta);
+
+            /** @brief Blend middlegame and endgame by phase into one white-relative score. */
+            static int Taper(const EvaluationScore& score);
+
+            /** @brief Material value of a piece of either colour, 0 for 'invalid'. */
+            static int GetPieceValue(PieceType piece);
+    };
+}
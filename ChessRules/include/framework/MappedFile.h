@@ -0,0 +1,49 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ */
+#pragma once
+
+#include<string>
+#include<string_view>
+
+namespace chess
+{
+    /**
+     * @brief Maps a file into memory for sequential reading.
+     *
+     * The contents are paged in by the operating system as they are read
+     * and can be dropped again under memory pressure, so files much larger
+     * than the available memory can be scanned through `GetData()` without
+     * copying them.
+     *
+     * Mapping is implemented for POSIX systems; elsewhere `Open` fails.
+     */
+    class MappedFile
+    {
+        public:
+            MappedFile();
+
+            /** @brief Unmaps the file. */
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * @brief Map a file, unmapping the previous one.
+             * @return False if the file could not be opened or mapped
+             */
+            bool Open(const std::string& path);
+
+            /** @brief Unmap the file; `GetData()` becomes empty. */
+            void Close();
+
+            /** @brief Whole file contents, valid until `Close`. */
+            std::string_view GetData() const { return std::string_view{mData, mSize}; }
+
+        private:
+            const char* mData; ///< Start of the mapping, null when closed
+            size_t mSize;      ///< Length of the file
+    };
+}
@@ -0,0 +1,152 @@
+/**
+ * @file Move.h
+ * @brief Packed 16-bit move encoding and a fixed-capacity move list.
+ */
+#pragma once
+
+#include<string>
+#include"framework/Bitboard.h"
+
+namespace chess
+{
+    /** @brief Upper bound on the number of moves in any legal chess position. */
+    constexpr int MAX_MOVES = 256;
+
+    /** @enum MoveFlag
+    * @brief Special move kinds stored in the top two bits of a `Move`.
+    */
+    enum class MoveFlag : uint16_t
+    {
+        Normal = 0,
+        Promotion = 1,
+        EnPassant = 2,
+        Castling = 3
+    };
+
+    /**
+     * @brief A move packed into 16 bits.
+     *
+     * Bits 0-5 hold the start square, bits 6-11 the end square, bits 12-13
+     * the promotion piece (bishop, knight, rook, queen in `PieceType` order)
+     * and bits 14-15 the `MoveFlag`. Colour is not stored; it is implied by
+     * the position the move is played in.
+     */
+    class Move
+    {
+        public:
+            /** @brief Uninitialised move (use `Move{}` for the null move). */
+            Move() = default;
+
+            /**
+             * @brief Construct a move.
+             * @param from Start square
+             * @param to End square
+             * @param flag Special move kind
+             * @param promotion Promotion piece of either colour (only used with MoveFlag::Promotion)
+             */
+            Move(int from, int to, MoveFlag flag = MoveFlag::Normal, PieceType promotion = PieceType::invalid)
+                :mData{static_cast<uint16_t>(from | (to << 6) | (static_cast<uint16_t>(flag) << 14))}
+            {
+                if(flag == MoveFlag::Promotion)
+                {
+                    mData |= static_cast<uint16_t>((abs(static_cast<int>(promotion)) - 2) << 12);
+                }
+            }
+
+            /** @brief Rebuild a move from `GetData()` (e.g. from a hash table entry). */
+            static Move FromData(uint16_t data)
+            {
+                Move move;
+                move.mData = data;
+                return move;
+            }
+
+            /** @brief Start square. */
+            int GetFrom() const { return mData & 0x3F; }
+            /** @brief End square. */
+            int GetTo() const { return (mData >> 6) & 0x3F; }
+            /** @brief Special move kind. */
+            MoveFlag GetFlag() const { return static_cast<MoveFlag>(mData >> 14); }
+            /** @brief Promotion piece for the given side, 'invalid' if not a promotion. */
+            PieceType GetPromotion(bool white) const
+            {
+                if(GetFlag() != MoveFlag::Promotion) return PieceType::invalid;
+                int piece = ((mData >> 12) & 0x3) + 2;
+                return static_cast<PieceType>(white ? piece : -piece);
+            }
+
+            /** @brief True for anything but the null move. */
+            bool IsValid() const { return mData != 0; }
+
+            /** @brief Raw 16-bit encoding. */
+            uint16_t GetData() const { return mData; }
+
+            /** @brief Long algebraic (UCI) notation such as "e2e4" or "e7e8q". */
+            std::string ToString() const
+            {
+                if(!IsValid()) return "0000";
+                ChessCoordinate from = ToChessCoordinate(GetFrom());
+                ChessCoordinate to = ToChessCoordinate(GetTo());
+                std::string text{from.file, static_cast<char>('0' + from.rank), to.file, static_cast<char>('0' + to.rank)};
+                if(GetFlag() == MoveFlag::Promotion)
+                {
+                    text += "bnrq"[(mData >> 12) & 0x3];
+                }
+                return text;
+            }
+
+            bool operator==(const Move& other) const { return mData == other.mData; }
+            bool operator!=(const Move& other) const { return mData != other.mData; }
+
+        private:
+            uint16_t mData; ///< Packed from/to/promotion/flag
+    };
+
+    /**
+     * @brief Fixed-capacity move container living on the stack.
+     *
+     * Move generation appends here instead of allocating a `List`.
+     */
+    class MoveList
+    {
+        public:
+            MoveList()
+                :mSize{0}
+            {
+            }
+
+            /** @brief Append a move. */
+            void Add(Move move) { mMoves[mSize++] = move; }
+
+            /** @brief Remove every move. */
+            void Clear() { mSize = 0; }
+
+            /** @brief Number of moves stored. */
+            int Size() const { return mSize; }
+
+            /** @brief True if no moves are stored. */
+            bool Empty() const { return mSize == 0; }
+
+            /** @brief Whether `move` is in the list. */
+            bool Contains(Move move) const
+            {
+                for(int i = 0; i < mSize; i++)
+                {
+                    if(mMoves[i] == move) return true;
+                }
+                return false;
+            }
+
+            Move& operator[](int index) { return mMoves[index]; }
+            Move operator[](int index) const { return mMoves[index]; }
+
+            Move* begin() { return mMoves; }
+            Move* end() { return mMoves + mSize; }
+            const Move* begin() const { return mMoves; }
+            const Move* end() const { return mMoves + mSize; }
+
+        private:
+            Move mMoves[MAX_MOVES]; ///< Storage, only the first mSize entries are meaningful
+            int mSize;              ///< Number of stored moves
+    };
+}
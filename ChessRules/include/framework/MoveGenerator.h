@@ -0,0 +1,89 @@
+/**
+ * @file MoveGenerator.h
+ * @brief Legal move generation for a `Position`, independent of any rendering.
+ */
+#pragma once
+
+#include"framework/Position.h"
+
+namespace chess
+{
+    /**
+     * @brief Generates the legal moves of the side to move in a `Position`.
+     *
+     * Checkers, pinned pieces and the squares attacked around the king are
+     * computed once per position, and every piece's targets are masked with
+     * them, so no move has to be played to find out whether it is legal.
+     * Works purely on bitboards and the attack tables, so it can be used by
+     * headless tools (perft, analysis) as well as the game.
+     */
+    class MoveGenerator
+    {
+        public:
+            /**
+             * @brief Append every legal move.
+             * @param position Position to generate for
+             * @param moves List the moves are appended to
+             */
+            static void GenerateLegalMoves(const Position& position, MoveList& moves);
+
+            /**
+             * @brief Append the legal captures and promotions (for quiescence search).
+             * @param position Position to generate for
+             * @param moves List the moves are appended to
+             */
+            static void GenerateLegalCaptures(const Position& position, MoveList& moves);
+
+            /** @brief Whether `move` is legal in `position`. */
+            static bool IsLegalMove(const Position& position, Move move);
+
+            /**
+             * @brief Resolve a move in coordinate notation ("e2e4", "e7e8q").
+             * @return The matching legal move, or the null move if there is none
+             */
+            static Move ParseMove(const Position& position, const std::string& text);
+
+        private:
+            /**
+             * @brief Shared implementation of the public generators.
+             * @param capturesOnly Only captures and promotions when true
+             */
+            static void Generate(const Position& position, MoveList& moves, bool capturesOnly);
+
+            /**
+             * @brief Per-position restrictions shared by every piece.
+             */
+            struct MoveMasks
+            {
+                int mKingSquare;        ///< Square of the side to move's king
+                uint64_t mCheckMask;    ///< Capture-or-block squares when in check, else every square
+                uint64_t mTargets;      ///< Squares a non-king move may end on (check mask minus own or non-enemy squares)
+                uint64_t mPinned;       ///< Own pieces pinned to the king
+                bool mCapturesOnly;     ///< Skip quiet moves other than promotions
+            };
+
+            /** @brief Own pieces that cannot leave the line between their king and an enemy slider. */
+            static uint64_t GetPinnedPieces(const Position& position, int kingSquare);
+
+            /** @brief Targets of a piece narrowed to its pin line if it is pinned. */
+            static uint64_t PinFilter(const MoveMasks& masks, int from, uint64_t targets);
+
+            /** @brief Pushes, double pushes, captures, en passant and promotions. */
+            static void GeneratePawnMoves(const Position& position, const MoveMasks& masks, MoveList& moves);
+
+            /** @brief Knight, bishop, rook and queen moves. */
+            static void GeneratePieceMoves(const Position& position, const MoveMasks& masks, MoveList& moves);
+
+            /** @brief Append one move per target square. */
+            static void AddMoves(int from, uint64_t targets, MoveList& moves);
+
+            /** @brief Append all four promotions of a pawn move. */
+            static void AddPromotions(int from, int to, MoveList& moves);
+
+            /**
+             * @brief Castling moves whose path is empty and not attacked.
+             * @param kingDanger Squares attacked by the opponent
+             */
+            static void GenerateCastlingMoves(const Position& position, uint64_t kingDanger, MoveList& moves);
+    };
+}
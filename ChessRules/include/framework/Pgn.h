@@ -0,0 +1,143 @@
+/**
+ * @file Pgn.h
+ * @brief Streaming Portable Game Notation (PGN) reader and writer.
+ */
+#pragma once
+
+#include<iosfwd>
+#include<string_view>
+#include"framework/Position.h"
+
+namespace chess
+{
+    class ChessState;
+
+    /**
+     * @brief One "[Name "Value"]" tag pair.
+     *
+     * Both views point into the text being read, and the value is kept as
+     * written, with `\"` and `\\` escapes; `PgnWriter` writes it back as is.
+     */
+    struct PgnTag
+    {
+        std::string_view mName;  ///< Tag name ("White", "FEN", ...)
+        std::string_view mValue; ///< Value between the quotes, still escaped
+    };
+
+    /**
+     * @brief What `PgnWriter` puts after a move.
+     */
+    struct PgnAnnotation
+    {
+        int mNag = 0;           ///< Numeric annotation glyph ("$2" is "?", "$4" is "??"), 0 for none
+        std::string mComment;   ///< Text of a "{...}" comment, none if empty
+    };
+
+    /**
+     * @brief A game as read from or written to PGN.
+     *
+     * Meant to be reused for every game of a file: `Clear` keeps the
+     * capacity of the lists, so reading does not allocate once they have
+     * grown to the longest game.
+     */
+    struct PgnGame
+    {
+        List<PgnTag> mTags;          ///< Tag pairs in file order
+        Position mStartPosition{};   ///< From the "FEN" tag, else the standard start
+        List<Move> mMoves;           ///< Mainline moves from `mStartPosition`
+        std::string_view mResult;    ///< "1-0", "0-1", "1/2-1/2" or "*"
+        bool mTruncated = false;     ///< A move or the FEN could not be resolved; `mMoves` stops before it
+        List<PgnAnnotation> mAnnotations; ///< Written after the move of the same index; not filled by `PgnReader`
+
+        /** @brief Value of a tag, empty if the game has none. */
+        std::string_view GetTag(std::string_view name) const;
+
+        /** @brief Forget the previous game, keeping the allocated capacity. */
+        void Clear();
+    };
+
+    /**
+     * @brief Pulls games one at a time out of PGN text.
+     *
+     * The text is usually a `MappedFile`, so a collection of any size is
+     * read with the memory of a single game: tokens are views into the text
+     * and SAN moves are resolved with `San::Parse` against the legal moves
+     * as they are read. Comments, variations, NAGs, move numbers and "%"
+     * escape lines are skipped; only the mainline is kept.
+     *
+     * A move that cannot be resolved truncates its game (see
+     * `PgnGame::mTruncated`) and the reader carries on with the next one.
+     */
+    class PgnReader
+    {
+        public:
+            /** @param text PGN text; must outlive the reader and the games it fills */
+            explicit PgnReader(std::string_view text);
+
+            /**
+             * @brief Read the next game.
+             * @param game Overwritten with the game
+             * @return False once the text is exhausted
+             */
+            bool ReadGame(PgnGame& game);
+
+            /** @brief Bytes consumed so far, for progress reporting. */
+            size_t GetOffset() const { return mOffset; }
+
+        private:
+            /** @brief Skip whitespace, comments, "%" escape lines and variations. */
+            void SkipSeparators();
+
+            /**
+             * @brief Skip a "{...}" comment, a ";..." or "%..." line, or a "(...)" variation.
+             * @return False if the current character starts none of them
+             */
+            bool SkipAnnotation();
+
+            /** @brief Parse one "[Name "Value"]" tag pair; a malformed one is skipped to the end of its line. */
+            void ReadTag(PgnGame& game);
+
+            /** @brief Everything up to the next separator or delimiter. */
+            std::string_view ReadToken();
+
+            /** @brief Skip characters up to and including `end` (or to the end of the text). */
+            void SkipPast(char end);
+
+            std::string_view mText; ///< Whole PGN text
+            size_t mOffset;         ///< Next character to read
+    };
+
+    /**
+     * @brief Writes games as export-format PGN.
+     *
+     * Movetext is written in SAN with move numbers and wrapped before 80
+     * columns; games are separated by a blank line so files can be
+     * appended to game by game.
+     */
+    class PgnWriter
+    {
+        public:
+            /**
+             * @brief Write the tags, then the moves from the start position and the result.
+             *
+             * Moves with an entry in `mAnnotations` are followed by its NAG
+             * and comment.
+             *
+             * A "FEN" tag is not added here; `mStartPosition` has to match
+             * whatever the tags say.
+             */
+            static void Write(std::ostream& output, const PgnGame& game);
+
+            /**
+             * @brief Write the game played so far in `state`.
+             *
+             * Uses the seven standard tags with unknown values ("?"), the
+             * result as of the current position, and "SetUp"/"FEN" tags if
+             * the game did not start from the standard position.
+             */
+            static void Write(std::ostream& output, const ChessState& state);
+
+            /** @brief PGN result token of a game state ("*" while it is ongoing). */
+            static std::string_view ResultOf(GameState state);
+    };
+}
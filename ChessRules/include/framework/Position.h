@@ -0,0 +1,202 @@
+/**
+ * @file Position.h
+ * @brief Copyable board position with make/unmake move support.
+ */
+#pragma once
+
+#include<string>
+#include<string_view>
+#include<type_traits>
+#include"framework/Bitboard.h"
+#include"framework/Move.h"
+
+namespace chess
+{
+    /** @brief Number of distinct piece types (6 per side). */
+    constexpr int PIECE_TYPE_COUNT = 12;
+
+    constexpr uint8_t CASTLE_WHITE_KING_SIDE  = 1; ///< White may still castle king side
+    constexpr uint8_t CASTLE_WHITE_QUEEN_SIDE = 2; ///< White may still castle queen side
+    constexpr uint8_t CASTLE_BLACK_KING_SIDE  = 4; ///< Black may still castle king side
+    constexpr uint8_t CASTLE_BLACK_QUEEN_SIDE = 8; ///< Black may still castle queen side
+    constexpr uint8_t CASTLE_ALL = 15;             ///< Every castling right
+
+    /**
+     * @brief Everything `Position::UnmakeMove` needs to restore the previous position.
+     */
+    struct UndoRecord
+    {
+        Move mMove;                 ///< Move that was played
+        PieceType mMovedPiece;      ///< Piece that moved
+        PieceType mCapturedPiece;   ///< Captured piece ('invalid' if none)
+        int8_t mEnPassantSquare;    ///< En passant square before the move
+        uint8_t mCastlingRights;    ///< Castling rights before the move
+        uint16_t mHalfMoveClock;    ///< Half-move clock before the move
+        uint64_t mHash;             ///< Zobrist key before the move
+    };
+
+    /**
+     * @brief Complete, trivially copyable chess position.
+     *
+     * Holds one bitboard per piece type plus side to move, castling rights,
+     * en passant square and move clocks. Unlike `ChessState` it is a plain
+     * value: copy it to analyse a line without touching the game in progress.
+     */
+    class Position
+    {
+        public:
+            /** @brief FEN of the standard initial position. */
+            static constexpr const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+            /** @brief Longest FEN `GetFen` can produce (71 placement characters, 17 for the other fields, 5 spaces). */
+            static constexpr size_t MAX_FEN_LENGTH = 96;
+
+            /** @brief Construct an empty board with white to move. */
+            Position();
+
+            /** @brief Reset to the standard initial chess position. */
+            void ResetToStartPosition();
+
+            /** @brief Remove every piece and reset rights and clocks. */
+            void Clear();
+
+            /**
+             * @brief Load a position from Forsyth-Edwards Notation without allocating.
+             *
+             * The half-move clock and full-move number are optional.
+             * @param fen FEN string
+             * @return false (leaving an empty board) if the string is malformed
+             */
+            bool SetFromFen(std::string_view fen);
+
+            /** @brief Forsyth-Edwards Notation of the position, all six fields. */
+            std::string GetFen() const;
+
+            /** @brief Get the piece occupying a square or 'invalid'. */
+            PieceType GetPieceOnSquare(int square) const;
+
+            /** @brief Bitboard of a single piece type. */
+            uint64_t GetPieceBitboard(PieceType piece) const { return mPieces[PieceIndex(piece)]; }
+
+            /** @brief Bitboard of every occupied square. */
+            uint64_t GetOccupancy() const { return mOccupancy[0] | mOccupancy[1]; }
+
+            /** @brief Bitboard of the squares occupied by one side. */
+            uint64_t GetOccupancy(bool white) const { return mOccupancy[white ? 0 : 1]; }
+
+            /** @brief Place a piece on an empty square. */
+            void SpawnPiece(PieceType piece, int square);
+
+            /** @brief Remove a piece from a square if it is there. */
+            void RemovePiece(PieceType piece, int square);
+
+            /**
+             * @brief Build a correctly flagged move from two squares.
+             *
+             * Detects en passant, castling (king moving two files) and
+             * promotion, so input coming from the board can be played.
+             * @param from Start square
+             * @param to End square
+             * @param promotion Piece to promote to; queen when 'invalid'
+             */
+            Move BuildMove(int from, int to, PieceType promotion = PieceType::invalid) const;
+
+            /**
+             * @brief Play a move without checking its legality.
+             *
+             * Handles captures, en passant, castling (the rook follows the
+             * king), promotion and all bookkeeping.
+             * @param move Move to play
+             * @param undo Filled with what `UnmakeMove` needs
+             * @return false if there is no piece on the start square
+             */
+            bool MakeMove(Move move, UndoRecord& undo);
+
+            /** @brief Take back the move described by `undo`. */
+            void UnmakeMove(const UndoRecord& undo);
+
+            /**
+             * @brief Squares attacked by one side.
+             * @param white True for white's attacks, false for black's.
+             * @param occupancy Occupancy seen by the sliding pieces.
+             */
+            uint64_t GetAttacks(bool white, uint64_t occupancy) const;
+
+            /**
+             * @brief Pieces of one side attacking a square.
+             * @param square Target square
+             * @param byWhite True for white attackers, false for black ones.
+             * @param occupancy Occupancy seen by the sliding pieces.
+             */
+            uint64_t GetAttackersTo(int square, bool byWhite, uint64_t occupancy) const;
+
+            /** @brief Whether any piece of the given side attacks `square`. */
+            bool IsSquareAttacked(int square, bool byWhite) const;
+
+            /** @brief True if the given side's king is attacked. */
+            bool IsInCheck(bool white) const;
+
+            /** @brief Play the move on a copy and report whether the mover's king ends up attacked. */
+            bool MoveLeavesKingInCheck(Move move) const;
+
+            /** @brief True if white is to move. */
+            bool IsWhiteToMove() const { return mWhiteToMove; }
+
+            /** @brief Current castling rights (CASTLE_* bits). */
+            uint8_t GetCastlingRights() const { return mCastlingRights; }
+
+            /** @brief Whether all of the given CASTLE_* bits are still set. */
+            bool HasCastlingRight(uint8_t rights) const { return (mCastlingRights & rights) == rights; }
+
+            /** @brief Square an enemy pawn can capture en passant onto, or NO_SQUARE. */
+            int GetEnPassantSquare() const { return mEnPassantSquare; }
+
+            /** @brief Zobrist key of the position, maintained incrementally. */
+            uint64_t GetHash() const { return mHash; }
+
+            /**
+             * @brief Zobrist key computed from scratch.
+             *
+             * Equal to `GetHash()` unless the incremental update is broken;
+             * build with CHESS_VERIFY_HASH to check that after every change.
+             */
+            uint64_t ComputeHash() const;
+
+            /** @brief Half moves since the last capture or pawn move (for 50-move rule). */
+            int GetHalfMoveClock() const { return mHalfMoveClock; }
+
+            /** @brief Full move number, starting at 1 and incremented after black's move. */
+            int GetFullMoveNumber() const { return mFullMoveNumber; }
+
+            /** @brief Index of a piece type into the bitboard array. */
+            static int PieceIndex(PieceType piece);
+
+            /** @brief Piece type stored at a bitboard array index. */
+            static PieceType PieceAtIndex(int index);
+
+            /** @brief True for white piece types. */
+            static bool IsWhitePiece(PieceType piece) { return static_cast<int>(piece) > 0; }
+
+        private:
+            /** @brief Castling rights removed when a piece leaves or lands on `square`. */
+            static uint8_t CastlingRightsLost(int square);
+
+            /** @brief Whether a pawn of the given side stands next to `square` ready to take en passant onto it. */
+            bool CanCaptureEnPassant(int square, bool byWhite) const;
+
+            /** @brief Compare the incremental key with `ComputeHash()` when CHESS_VERIFY_HASH is defined. */
+            void VerifyHash() const;
+
+            uint64_t mPieces[PIECE_TYPE_COUNT]; ///< One bitboard per piece type (white first)
+            uint64_t mOccupancy[2];             ///< [white, black] occupancy
+
+            bool mWhiteToMove;                  ///< Side to move
+            uint8_t mCastlingRights;            ///< CASTLE_* bits
+            int8_t mEnPassantSquare;            ///< En passant target or NO_SQUARE
+            uint16_t mHalfMoveClock;            ///< Half moves since capture/pawn move
+            uint16_t mFullMoveNumber;           ///< Full move counter
+            uint64_t mHash;                     ///< Zobrist key
+    };
+
+    static_assert(std::is_trivially_copyable<Position>::value, "Position must stay cheap to copy");
+}
@@ -0,0 +1,46 @@
+/**
+ * @file San.h
+ * @brief Standard Algebraic Notation (SAN) parsing and formatting.
+ */
+#pragma once
+
+#include<string_view>
+#include"framework/Position.h"
+
+namespace chess
+{
+    /**
+     * @brief Converts between SAN ("Nbd7", "exd8=Q+", "O-O") and `Move`.
+     *
+     * Both directions work against the legal moves of a position, so a
+     * parsed move is always legal and a written one carries exactly the
+     * disambiguation it needs. Neither direction allocates.
+     */
+    class San
+    {
+        public:
+            /** @brief Room for the longest SAN `Write` produces ("exd8=Q+" and "Qa1xb2#" are 7 characters). */
+            static constexpr size_t MAX_SAN_LENGTH = 8;
+
+            /**
+             * @brief Resolve a SAN move.
+             *
+             * Check and annotation suffixes ("+", "#", "!", "?") are ignored,
+             * castling may be written with 'O' or '0', and a promotion with
+             * or without '='.
+             * @return The one legal move the text describes, or the null move
+             *         if it describes none or is ambiguous
+             */
+            static Move Parse(const Position& position, std::string_view text);
+
+            /**
+             * @brief Write a legal move in SAN, including "+" or "#".
+             * @param buffer Receives the text, not null-terminated
+             * @return Number of characters written (at most MAX_SAN_LENGTH)
+             */
+            static size_t Write(const Position& position, Move move, char (&buffer)[MAX_SAN_LENGTH]);
+
+            /** @brief `Write` into a string. */
+            static std::string ToString(const Position& position, Move move);
+    };
+}
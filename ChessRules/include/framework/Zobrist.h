@@ -0,0 +1,50 @@
+/**
+ * @file Zobrist.h
+ * @brief Random keys for 64-bit Zobrist position hashing.
+ */
+#pragma once
+
+#include"framework/Bitboard.h"
+
+namespace chess
+{
+    /**
+     * @brief Singleton holding the Zobrist keys.
+     *
+     * A position's key is the XOR of one key per (piece, square), the side
+     * key when black is to move, the key of the castling rights and the key
+     * of the en passant file. Because XOR is its own inverse, a move only
+     * XORs in the handful of keys it changes. The keys come from a fixed
+     * seed so hashes are identical between runs.
+     */
+    class Zobrist
+    {
+        public:
+            /** @brief Get the global singleton instance. */
+            static Zobrist& Get();
+
+            /** @brief Key of a piece standing on a square. */
+            uint64_t GetPieceKey(int pieceIndex, int square) const { return mPieceKeys[pieceIndex][square]; }
+            /** @brief Key of a set of castling rights (CASTLE_* bits). */
+            uint64_t GetCastlingKey(uint8_t rights) const { return mCastlingKeys[rights]; }
+            /** @brief Key of an en passant square, 0 for NO_SQUARE. */
+            uint64_t GetEnPassantKey(int square) const { return square == NO_SQUARE ? 0 : mEnPassantKeys[FileOf(square)]; }
+            /** @brief Key toggled when black is to move. */
+            uint64_t GetSideKey() const { return mSideKey; }
+
+        protected:
+            /** @brief Construct hidden for singleton pattern; generates all keys. */
+            Zobrist();
+
+        private:
+            /** @brief SplitMix64 step used to generate the keys. */
+            static uint64_t NextRandom(uint64_t& state);
+
+            static unique<Zobrist> mZobrist; ///< Singleton instance
+
+            uint64_t mPieceKeys[12][SQUARE_COUNT];  ///< Per piece index and square
+            uint64_t mCastlingKeys[16];             ///< Per combination of castling rights
+            uint64_t mEnPassantKeys[8];             ///< Per en passant file
+            uint64_t mSideKey;                      ///< Black to move
+    };
+}
@@ -0,0 +1,274 @@
+/**
+ * @file AttackTable.cpp
+ * @brief Construction of the precomputed attack tables and sliding-piece lookups.
+ */
+#include"framework/AttackTable.h"
+#include<mutex>
+
+namespace chess
+{
+    unique<AttackTable> AttackTable::mAttackTable{nullptr};
+
+    namespace
+    {
+        std::once_flag sAttackTableOnce;    ///< Guards the lazy construction of `mAttackTable`
+    }
+
+    /**
+     * @brief Get the singleton instance of `AttackTable`.
+     *
+     * Lazily builds every table on first use. Search threads may be the
+     * first to call this, so construction happens exactly once across threads.
+     * @return Reference to the global `AttackTable`.
+     */
+    AttackTable& AttackTable::Get()
+    {
+        std::call_once(sAttackTableOnce, []()
+        {
+            mAttackTable = std::move(unique<AttackTable>{new AttackTable});
+        });
+        return *mAttackTable;
+    }
+
+    /**
+     * @brief Build all tables once.
+     */
+    AttackTable::AttackTable()
+        :mPawnAttacks{},
+        mKnightAttacks{},
+        mKingAttacks{},
+        mRays{},
+        mBetween{},
+        mLine{},
+        mRookMagics{},
+        mBishopMagics{},
+        mRookTable(ROOK_TABLE_SIZE),
+        mBishopTable(BISHOP_TABLE_SIZE)
+    {
+        InitLeaperAttacks();
+        InitRays();
+        InitLines();
+
+        Direction rookDirections[4] = {North, South, East, West};
+        Direction bishopDirections[4] = {NorthEast, NorthWest, SouthEast, SouthWest};
+        InitMagics(mRookMagics, mRookTable.data(), rookDirections);
+        InitMagics(mBishopMagics, mBishopTable.data(), bishopDirections);
+    }
+
+    /**
+     * @brief Precompute pawn capture, knight and king targets for every square.
+     */
+    void AttackTable::InitLeaperAttacks()
+    {
+        int whitePawnRank[2] = {  1,  1};
+        int blackPawnRank[2] = { -1, -1};
+        int pawnFile[2]      = { -1,  1};
+
+        int knightRank[8] = {  2,   2, -2, -2,  1, -1,  1, -1};
+        int knightFile[8] = {  1,  -1,  1, -1,  2,  2, -2, -2};
+
+        int kingRank[8] = { -1,  -1,  1,  1,  1, -1,  0,  0};
+        int kingFile[8] = {  1,  -1, -1,  1,  0,  0,  1, -1};
+
+        for(int square = 0; square < SQUARE_COUNT; square++)
+        {
+            mPawnAttacks[0][square] = StepAttacks(square, whitePawnRank, pawnFile, 2);
+            mPawnAttacks[1][square] = StepAttacks(square, blackPawnRank, pawnFile, 2);
+            mKnightAttacks[square] = StepAttacks(square, knightRank, knightFile, 8);
+            mKingAttacks[square] = StepAttacks(square, kingRank, kingFile, 8);
+        }
+    }
+
+    /**
+     * @brief Precompute empty-board rays in all eight directions.
+     */
+    void AttackTable::InitRays()
+    {
+        int offsetRank[DirectionCount] = { 1,  0,  1,  1, -1,  0, -1, -1};
+        int offsetFile[DirectionCount] = { 0, -1,  1, -1,  0,  1,  1, -1};
+
+        for(int square = 0; square < SQUARE_COUNT; square++)
+        {
+            for(int direction = 0; direction < DirectionCount; direction++)
+            {
+                ChessCoordinate iter = ToChessCoordinate(square);
+                iter.rank += offsetRank[direction];
+                iter.file += offsetFile[direction];
+                while(iter.isValid())
+                {
+                    mRays[direction][square] |= SquareBit(ToSquare(iter));
+                    iter.rank += offsetRank[direction];
+                    iter.file += offsetFile[direction];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Precompute the squares between and the line through every aligned pair.
+     *
+     * Used for check evasions (block or capture the checker) and for
+     * keeping pinned pieces on their pin ray.
+     */
+    void AttackTable::InitLines()
+    {
+        const Direction opposite[DirectionCount] = {South, East, SouthWest, SouthEast, North, West, NorthWest, NorthEast};
+
+        for(int from = 0; from < SQUARE_COUNT; from++)
+        {
+            for(int direction = 0; direction < DirectionCount; direction++)
+            {
+                uint64_t ray = mRays[direction][from];
+                uint64_t line = ray | mRays[opposite[direction]][from] | SquareBit(from);
+                while(ray)
+                {
+                    int to = PopLowestSquare(ray);
+                    mBetween[from][to] = mRays[direction][from] & ~mRays[direction][to] & ~SquareBit(to);
+                    mLine[from][to] = line;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Build the magic entries and attack slices of one slider type.
+     *
+     * For every square all blocker subsets of the relevant mask are
+     * enumerated (Carry-Rippler) together with their ray-walked attacks. With
+     * BMI2 the PEXT index is used directly; otherwise sparse random numbers
+     * from a fixed-seed generator are tried until one maps every subset
+     * without a destructive collision. `epoch` avoids clearing the slice
+     * between failed attempts.
+     */
+    void AttackTable::InitMagics(Magic *magics, uint64_t *table, const Direction *directions)
+    {
+        List<uint64_t> occupancies(4096);
+        List<uint64_t> reference(4096);
+        List<int> epoch(4096, 0);
+        int attempt = 0;
+        uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+        uint64_t* slice = table;
+        for(int square = 0; square < SQUARE_COUNT; square++)
+        {
+            Magic& entry = magics[square];
+
+            // A blocker on the last square of a ray never hides anything, so edges are not relevant
+            entry.mask = 0;
+            for(int i = 0; i < 4; i++)
+            {
+                uint64_t ray = mRays[directions[i]][square];
+                if(ray)
+                {
+                    ray ^= SquareBit(directions[i] < South ? HighestSquare(ray) : LowestSquare(ray));
+                }
+                entry.mask |= ray;
+            }
+            entry.shift = 64 - PopCount(entry.mask);
+            entry.attacks = slice;
+
+            int size = 0;
+            uint64_t subset = 0;
+            do
+            {
+                occupancies[size] = subset;
+                reference[size] = GetSlidingAttacks(square, subset, directions);
+                size++;
+                subset = (subset - entry.mask) & entry.mask;
+            } while(subset);
+            slice += size;
+
+        #if defined(__BMI2__)
+            entry.magic = 0;
+            for(int i = 0; i < size; i++)
+            {
+                entry.attacks[entry.Index(occupancies[i])] = reference[i];
+            }
+        #else
+            uint64_t seed = seeds[RankOf(square)];
+            for(int i = 0; i < size;)
+            {
+                do
+                {
+                    entry.magic = NextRandom(seed) & NextRandom(seed) & NextRandom(seed);
+                } while(PopCount((entry.mask * entry.magic) >> 56) < 6);
+
+                attempt++;
+                for(i = 0; i < size; i++)
+                {
+                    unsigned index = entry.Index(occupancies[i]);
+                    if(epoch[index] < attempt)
+                    {
+                        epoch[index] = attempt;
+                        entry.attacks[index] = reference[i];
+                    }
+                    else if(entry.attacks[index] != reference[i])
+                    {
+                        break;
+                    }
+                }
+            }
+        #endif
+        }
+    }
+
+    /**
+     * @brief Union of the blocker-aware rays of a slider.
+     */
+    uint64_t AttackTable::GetSlidingAttacks(int square, uint64_t occupancy, const Direction *directions) const
+    {
+        uint64_t attacks = 0;
+        for(int i = 0; i < 4; i++)
+        {
+            attacks |= GetRayAttacks(square, occupancy, directions[i]);
+        }
+        return attacks;
+    }
+
+    /**
+     * @brief Attacks along a single ray, cut after the nearest blocker.
+     *
+     * Rays towards higher indices find their blocker with a forward bit scan,
+     * the others with a reverse scan.
+     */
+    uint64_t AttackTable::GetRayAttacks(int square, uint64_t occupancy, Direction direction) const
+    {
+        uint64_t attacks = mRays[direction][square];
+        uint64_t blockers = attacks & occupancy;
+        if(blockers)
+        {
+            int blocker = direction < South ? LowestSquare(blockers) : HighestSquare(blockers);
+            attacks ^= mRays[direction][blocker];
+        }
+        return attacks;
+    }
+
+    /**
+     * @brief Collect on-board targets of fixed (rank, file) offsets.
+     */
+    uint64_t AttackTable::StepAttacks(int square, const int *offsetRank, const int *offsetFile, int count)
+    {
+        uint64_t attacks = 0;
+        ChessCoordinate start = ToChessCoordinate(square);
+        for(int i = 0; i < count; i++)
+        {
+            ChessCoordinate end{start.rank + offsetRank[i], static_cast<char>(start.file + offsetFile[i])};
+            if(end.isValid())
+            {
+                attacks |= SquareBit(ToSquare(end));
+            }
+        }
+        return attacks;
+    }
+
+    /**
+     * @brief xorshift64* step used for the deterministic magic search.
+     */
+    uint64_t AttackTable::NextRandom(uint64_t &state)
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * UINT64_C(2685821657736338717);
+    }
+}
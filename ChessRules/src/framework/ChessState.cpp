@@ -0,0 +1,410 @@
+/**
+ * @file ChessState.cpp
+ * @brief Implementation of the game state wrapper, move logging, and queries.
+ */
+#include"framework/ChessState.h"
+#include<algorithm>
+
+namespace chess
+{
+    unique<ChessState> ChessState::mChessState{nullptr};
+    /**
+     * @brief Get the singleton instance of `ChessState`.
+     *
+     * Lazily constructs the instance on first use. The state holds the
+     * current position and the history needed to undo moves.
+     * @return Reference to the global `ChessState`.
+     */
+    ChessState& ChessState::Get()
+    {
+        if(!mChessState)
+        {
+            mChessState = std::move(unique<ChessState>{new ChessState});
+        }
+        return *mChessState;
+    }
+
+    /**
+     * @brief Reset the position to the initial chess position.
+     *
+     * Clears the move log and recomputes attacked squares.
+     */
+    void ChessState::ResetToStartPosition()
+    {
+        SetFromFen(Position::START_FEN);
+    }
+
+    /**
+     * @brief Load the position, then rebuild everything derived from it.
+     *
+     * The position is parsed into a copy first so a malformed FEN leaves
+     * the game untouched.
+     */
+    bool ChessState::SetFromFen(std::string_view fen)
+    {
+        Position position;
+        if(!position.SetFromFen(fen))
+            return false;
+
+        mPosition = position;
+        mStartPosition = position;
+        mMovesPlayed.clear();
+        mMaterialSignature = ComputeMaterialSignature(mPosition);
+        mEvaluation = Evaluation::ComputeScore(mPosition);
+        mPositionCounts.clear();
+        UpdateRepetitionCount(1);
+
+        UpdateAttackedSquare();
+        return true;
+    }
+
+    /**
+     * @brief Collect coordinates of all pieces of a given type.
+     * @param piece One of the defined piece constants (e.g., whitePawn).
+     * @return List of board coordinates where the piece currently exists.
+     */
+    List<ChessCoordinate> ChessState::GetPiecePosiiton(PieceType piece)
+    {
+        List<ChessCoordinate> position;
+        position.reserve(8);
+        uint64_t pieceContainer = mPosition.GetPieceBitboard(piece);
+
+        while(pieceContainer)
+        {
+            position.emplace_back(ToChessCoordinate(PopLowestSquare(pieceContainer)));
+        }
+
+        return position;
+    }
+
+    /**
+     * @brief Play a move on the position and log it.
+     *
+     * `Position::MakeMove` takes care of captures (including en passant),
+     * castling, promotion and castling rights; the material signature,
+     * evaluation and repetition counts are adjusted from the undo record.
+     * @param piece Piece identifier.
+     * @param start Start coordinate (must be valid and contain the piece).
+     * @param end Destination coordinate (must be valid).
+     * @param promotion Promotion piece for pawns reaching the last rank.
+     */
+    void ChessState::SetPiecePosition(PieceType piece, ChessCoordinate &start, ChessCoordinate &end, PieceType promotion)
+    {
+        if(!start.isValid() || !end.isValid()) return;
+        if(mPosition.GetPieceOnSquare(ToSquare(start)) != piece) return;
+
+        UndoRecord move;
+        if(mPosition.MakeMove(mPosition.BuildMove(ToSquare(start), ToSquare(end), promotion), move))
+        {
+            mMovesPlayed.emplace_back(move);
+            UpdateMove(move, 1);
+            UpdateRepetitionCount(1);
+        }
+
+        UpdateAttackedSquare();
+    }
+
+    /**
+     * @brief Undo the last move from history and restore the previous position.
+     * @return true if a move was undone; false if history is empty.
+     */
+    bool ChessState::UndoLastMove()
+    {
+        if(mMovesPlayed.size() == 0) return false;
+
+        const UndoRecord& move = mMovesPlayed.back();
+        UpdateRepetitionCount(-1);
+        UpdateMove(move, -1);
+
+        mPosition.UnmakeMove(move);
+        mMovesPlayed.pop_back();
+
+        UpdateAttackedSquare();
+        return true;
+    }
+
+    /**
+     * @brief Query the piece occupying a coordinate.
+     * @param coordinate Board coordinate to check.
+     * @return Piece identifier at the square, or `invalid` if empty or off-board.
+     */
+    PieceType ChessState::GetPieceOnChessCoordinate(ChessCoordinate coordinate)
+    {
+        if(!coordinate.isValid()) return PieceType::invalid;
+        return mPosition.GetPieceOnSquare(ToSquare(coordinate));
+    }
+
+    /**
+     * @brief Remove a specific piece from a board position.
+     * @param piece Piece identifier to remove.
+     * @param position The coordinate from which to remove the piece.
+     */
+    void ChessState::RemovePiece(PieceType piece, ChessCoordinate &position)
+    {
+        if(piece == PieceType::invalid || !position.isValid())return;
+        if(mPosition.GetPieceOnSquare(ToSquare(position)) != piece) return;
+
+        UpdateRepetitionCount(-1);
+        mPosition.RemovePiece(piece, ToSquare(position));
+        UpdatePiece(piece, ToSquare(position), -1);
+        UpdateRepetitionCount(1);
+        UpdateAttackedSquare();
+    }
+
+    /**
+     * @brief Determine whether the given side's king is in check.
+     * @param white True to test white's king; false to test black's king.
+     * @return true if the king is currently attacked.
+     */
+    bool ChessState::KingInCheck(bool white)
+    {
+        return mPosition.IsInCheck(white);
+    }
+
+    /**
+     * @brief Get the last move played.
+     * @return The move, or the null move (`Move{}`) if none has been played.
+     */
+    Move ChessState::GetLastPlayedMove()
+    {
+        if(mMovesPlayed.size() == 0)return Move{};
+        return mMovesPlayed.back().mMove;
+    }
+    
+    /**
+     * @brief Count the number of pieces of a given type on the board.
+     * @param piece Piece identifier (whitePawn, blackQueen, etc.).
+     * @return Number of set bits in the corresponding bitboard.
+     */
+    int ChessState::GetPieceCount(PieceType piece)
+    {
+        return PopCount(mPosition.GetPieceBitboard(piece));
+    }
+
+    /**
+     * @brief Number of half moves since the last capture or pawn move (kept by `Position`).
+     */
+    int ChessState::GetMovesWithoutCapture()
+    {
+        return mPosition.GetHalfMoveClock();
+    }
+
+    /**
+     * @brief Three occurrences of the same Zobrist key (side to move, castling and en passant included).
+     */
+    bool ChessState::IsThreefoldRepetition() const
+    {
+        return GetRepetitionCount() >= 3;
+    }
+
+    /**
+     * @brief Look the current key up in the occurrence counts.
+     *
+     * Positions from before a capture or pawn move can never come back, so
+     * counting over the whole game gives the same answer as counting since
+     * the last irreversible move.
+     */
+    int ChessState::GetRepetitionCount() const
+    {
+        auto count = mPositionCounts.find(mPosition.GetHash());
+        return count == mPositionCounts.end() ? 0 : count->second;
+    }
+
+    /**
+     * @brief Each undo record holds the key of the position the move was played from.
+     */
+    List<uint64_t> ChessState::GetHashHistory() const
+    {
+        List<uint64_t> history;
+        history.reserve(mMovesPlayed.size());
+        for(const UndoRecord& record : mMovesPlayed)
+            history.push_back(record.mHash);
+        return history;
+    }
+
+    /**
+     * @brief Moves of the undo records, in the order they were played.
+     */
+    List<Move> ChessState::GetMovesPlayed() const
+    {
+        List<Move> moves;
+        moves.reserve(mMovesPlayed.size());
+        for(const UndoRecord& record : mMovesPlayed)
+            moves.push_back(record.mMove);
+        return moves;
+    }
+
+    /**
+     * @brief Decide whether the game is over.
+     *
+     * Without a legal move the side to move is either mated or stalemated.
+     * A draw is also declared after 100 half moves without a capture or pawn
+     * move, on threefold repetition, or when neither side has mating
+     * material left. Every input is already cached, so nothing is scanned.
+     */
+    GameState ChessState::ComputeGameState() const
+    {
+        bool white = mPosition.IsWhiteToMove();
+
+        if(mLegalMoves.Empty())
+        {
+            if(!mPosition.IsInCheck(white)) return GameState::Draw;
+            return white ? GameState::BlackWon : GameState::WhiteWon;
+        }
+
+        // 50 move rule
+        if(mPosition.GetHalfMoveClock() >= 100) return GameState::Draw;
+
+        if(IsThreefoldRepetition()) return GameState::Draw;
+
+        if(IsInsufficientMaterial(mMaterialSignature)) return GameState::Draw;
+
+        return GameState::Ongoing;
+    }
+
+    /**
+     * @brief Add `delta` to the four-bit counter of `piece` and its evaluation sums.
+     */
+    void ChessState::UpdatePiece(PieceType piece, int square, int delta)
+    {
+        if(piece == PieceType::invalid) return;
+        int shift = 4 * Position::PieceIndex(piece);
+        mMaterialSignature += static_cast<uint64_t>(static_cast<int64_t>(delta)) << shift;
+        Evaluation::UpdateScore(mEvaluation, piece, square, delta);
+    }
+
+    /**
+     * @brief Replay the piece changes `Position::MakeMove` made for this move.
+     *
+     * The moved piece leaves its square and arrives (possibly promoted) on
+     * the target, a captured piece leaves its square (behind the target for
+     * en passant) and castling also moves the rook. Reverting applies the
+     * same changes with the opposite sign.
+     */
+    void ChessState::UpdateMove(const UndoRecord &move, int delta)
+    {
+        int from = move.mMove.GetFrom();
+        int to = move.mMove.GetTo();
+        bool white = Position::IsWhitePiece(move.mMovedPiece);
+        MoveFlag flag = move.mMove.GetFlag();
+
+        UpdatePiece(move.mMovedPiece, from, -delta);
+        UpdatePiece(flag == MoveFlag::Promotion ? move.mMove.GetPromotion(white) : move.mMovedPiece, to, delta);
+        UpdatePiece(move.mCapturedPiece, flag == MoveFlag::EnPassant ? (white ? to - 8 : to + 8) : to, -delta);
+
+        if(flag == MoveFlag::Castling)
+        {
+            bool kingSide = FileOf(to) > FileOf(from);
+            int backRank = RankOf(from) + 1;
+            PieceType rook = white ? PieceType::whiteRook : PieceType::blackRook;
+            UpdatePiece(rook, ToSquare(backRank, kingSide ? 'h' : 'a'), -delta);
+            UpdatePiece(rook, ToSquare(backRank, kingSide ? 'f' : 'd'), delta);
+        }
+    }
+
+    /**
+     * @brief Adjust the occurrence count of the current key, forgetting keys that drop to zero.
+     */
+    void ChessState::UpdateRepetitionCount(int delta)
+    {
+        int& count = mPositionCounts[mPosition.GetHash()];
+        count += delta;
+        if(count <= 0)
+            mPositionCounts.erase(mPosition.GetHash());
+    }
+
+    /**
+     * @brief Read the four-bit counter of `piece`.
+     */
+    int ChessState::GetMaterialCount(uint64_t signature, PieceType piece)
+    {
+        return static_cast<int>((signature >> (4 * Position::PieceIndex(piece))) & 0xF);
+    }
+
+    /**
+     * @brief Pack the piece counts of a whole position.
+     */
+    uint64_t ChessState::ComputeMaterialSignature(const Position &position)
+    {
+        uint64_t signature = 0;
+        for(int index = 0; index < 12; index++)
+        {
+            signature |= static_cast<uint64_t>(std::min(PopCount(position.GetPieceBitboard(Position::PieceAtIndex(index))), 15)) << (4 * index);
+        }
+        return signature;
+    }
+
+    /**
+     * @brief Only minor pieces left, and no side has two bishops or bishop and knight.
+     */
+    bool ChessState::IsInsufficientMaterial(uint64_t signature)
+    {
+        if(GetMaterialCount(signature, PieceType::whiteQueen) || GetMaterialCount(signature, PieceType::blackQueen)
+            || GetMaterialCount(signature, PieceType::whiteRook) || GetMaterialCount(signature, PieceType::blackRook)
+            || GetMaterialCount(signature, PieceType::whitePawn) || GetMaterialCount(signature, PieceType::blackPawn))
+            return false;
+
+        int whiteBishops = GetMaterialCount(signature, PieceType::whiteBishop);
+        int blackBishops = GetMaterialCount(signature, PieceType::blackBishop);
+        if(whiteBishops >= 2 || blackBishops >= 2
+            || (whiteBishops && GetMaterialCount(signature, PieceType::whiteKnight))
+            || (blackBishops && GetMaterialCount(signature, PieceType::blackKnight)))
+            return false;
+
+        return true;
+    }
+
+    /**
+     * @brief Construct `ChessState` and set up the start position.
+     */
+    ChessState::ChessState()
+        : mPosition{},
+          mStartPosition{},
+          mWhiteAttacks{0},
+          mBlackAttacks{0},
+          mLegalMoves{},
+          mMovesPlayed{},
+          mMaterialSignature{0},
+          mEvaluation{},
+          mPositionCounts{},
+          mGameState{GameState::Ongoing}
+    {
+        ResetToStartPosition();
+    }
+
+    /**
+     * @brief Recompute white/black attacked-square bitboards, the legal moves and the game state.
+     *
+     * Sliding attacks are computed with the defending king removed from the
+     * occupancy so a checked king cannot step back along the checking ray.
+     */
+    void ChessState::UpdateAttackedSquare()
+    {
+        uint64_t occupancy = mPosition.GetOccupancy();
+
+        mWhiteAttacks = mPosition.GetAttacks(true, occupancy & ~mPosition.GetPieceBitboard(PieceType::blackKing));
+        mBlackAttacks = mPosition.GetAttacks(false, occupancy & ~mPosition.GetPieceBitboard(PieceType::whiteKing));
+
+        mLegalMoves.Clear();
+        MoveGenerator::GenerateLegalMoves(mPosition, mLegalMoves);
+
+        mGameState = ComputeGameState();
+    }
+
+    /**
+     * @brief Place a piece on the board at the given coordinate.
+     * @param piece Piece to place.
+     * @param position Target square (must be valid).
+     */
+    void ChessState::SpawnPiece(PieceType piece, ChessCoordinate &position)
+    {
+        if(piece == PieceType::invalid || !position.isValid()) return;
+        if(mPosition.GetPieceOnSquare(ToSquare(position)) != PieceType::invalid) return;
+
+        UpdateRepetitionCount(-1);
+        mPosition.SpawnPiece(piece, ToSquare(position));
+        UpdatePiece(piece, ToSquare(position), 1);
+        UpdateRepetitionCount(1);
+        UpdateAttackedSquare();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+/**
+ * @file Evaluation.cpp
+ * @brief Material values and middlegame/endgame piece-square tables.
+ */
+#include"framework/Evaluation.h"
+#include<algorithm>
+
+namespace chess
+{
+    namespace
+    {
+        /** @brief Values indexed by abs(PieceType): pawn, bishop, knight, rook, queen, king. */
+        const int PIECE_VALUES[7] = {0, 100, 330, 320, 500, 900, 0};
+
+        /** @brief Endgame values; pawns gain weight as they get closer to promoting. */
+        const int ENDGAME_PIECE_VALUES[7] = {0, 120, 330, 320, 500, 900, 0};
+
+        /** @brief Contribution to the game phase, indexed by abs(PieceType). */
+        const int PHASE_WEIGHTS[7] = {0, 0, 1, 1, 2, 4, 0};
+
+        // Piece-square tables from white's point of view, a8 first and h1 last
+        const int PAWN_TABLE[SQUARE_COUNT] = {
+             0,  0,  0,  0,  0,  0,  0,  0,
+            50, 50, 50, 50, 50, 50, 50, 50,
+            10, 10, 20, 30, 30, 20, 10, 10,
+             5,  5, 10, 25, 25, 10,  5,  5,
+             0,  0,  0, 20, 20,  0,  0,  0,
+             5, -5,-10,  0,  0,-10, -5,  5,
+             5, 10, 10,-20,-20, 10, 10,  5,
+             0,  0,  0,  0,  0,  0,  0,  0
+        };
+
+        const int KNIGHT_TABLE[SQUARE_COUNT] = {
+            -50,-40,-30,-30,-30,-30,-40,-50,
+            -40,-20,  0,  0,  0,  0,-20,-40,
+            -30,  0, 10, 15, 15, 10,  0,-30,
+            -30,  5, 15, 20, 20, 15,  5,-30,
+            -30,  0, 15, 20, 20, 15,  0,-30,
+            -30,  5, 10, 15, 15, 10,  5,-30,
+            -40,-20,  0,  5,  5,  0,-20,-40,
+            -50,-40,-30,-30,-30,-30,-40,-50
+        };
+
+        const int BISHOP_TABLE[SQUARE_COUNT] = {
+            -20,-10,-10,-10,-10,-10,-10,-20,
+            -10,  0,  0,  0,  0,  0,  0,-10,
+            -10,  0,  5, 10, 10,  5,  0,-10,
+            -10,  5,  5, 10, 10,  5,  5,-10,
+            -10,  0, 10, 10, 10, 10,  0,-10,
+            -10, 10, 10, 10, 10, 10, 10,-10,
+            -10,  5,  0,  0,  0,  0,  5,-10,
+            -20,-10,-10,-10,-10,-10,-10,-20
+        };
+
+        const int ROOK_TABLE[SQUARE_COUNT] = {
+             0,  0,  0,  0,  0,  0,  0,  0,
+             5, 10, 10, 10, 10, 10, 10,  5,
+            -5,  0,  0,  0,  0,  0,  0, -5,
+            -5,  0,  0,  0,  0,  0,  0, -5,
+            -5,  0,  0,  0,  0,  0,  0, -5,
+            -5,  0,  0,  0,  0,  0,  0, -5,
+            -5,  0,  0,  0,  0,  0,  0, -5,
+             0,  0,  0,  5,  5,  0,  0,  0
+        };
+
+        const int QUEEN_TABLE[SQUARE_COUNT] = {
+            -20,-10,-10, -5, -5,-10,-10,-20,
+            -10,  0,  0,  0,  0,  0,  0,-10,
+            -10,  0,  5,  5,  5,  5,  0,-10,
+             -5,  0,  5,  5,  5,  5,  0, -5,
+              0,  0,  5,  5,  5,  5,  0, -5,
+            -10,  5,  5,  5,  5,  5,  0,-10,
+            -10,  0,  5,  0,  0,  0,  0,-10,
+            -20,-10,-10, -5, -5,-10,-10,-20
+        };
+
+        const int KING_TABLE[SQUARE_COUNT] = {
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -20,-30,-30,-40,-40,-30,-30,-20,
+            -10,-20,-20,-20,-20,-20,-20,-10,
+             20, 20,  0,  0,  0,  0, 20, 20,
+             20, 30, 10,  0,  0, 10, 30, 20
+        };
+
+        const int ENDGAME_PAWN_TABLE[SQUARE_COUNT] = {
+             0,  0,  0,  0,  0,  0,  0,  0,
+            80, 80, 80, 80, 80, 80, 80, 80,
+            50, 50, 50, 50, 50, 50, 50, 50,
+            30, 30, 30, 30, 30, 30, 30, 30,
+            15, 15, 15, 15, 15, 15, 15, 15,
+             5,  5,  5,  5,  5,  5,  5,  5,
+             0,  0,  0,  0,  0,  0,  0,  0,
+             0,  0,  0,  0,  0,  0,  0,  0
+        };
+
+        const int ENDGAME_KING_TABLE[SQUARE_COUNT] = {
+            -50,-40,-30,-20,-20,-30,-40,-50,
+            -30,-20,-10,  0,  0,-10,-20,-30,
+            -30,-10, 20, 30, 30, 20,-10,-30,
+            -30,-10, 30, 40, 40, 30,-10,-30,
+            -30,-10, 30, 40, 40, 30,-10,-30,
+            -30,-10, 20, 30, 30, 20,-10,-30,
+            -30,-30,  0,  0,  0,  0,-30,-30,
+            -50,-30,-30,-30,-30,-30,-30,-50
+        };
+
+        /** @brief Middlegame tables indexed by abs(PieceType). */
+        const int* const PIECE_TABLES[7] = {nullptr, PAWN_TABLE, BISHOP_TABLE, KNIGHT_TABLE, ROOK_TABLE, QUEEN_TABLE, KING_TABLE};
+
+        /** @brief Endgame tables; only pawns and the king behave differently. */
+        const int* const ENDGAME_PIECE_TABLES[7] = {nullptr, ENDGAME_PAWN_TABLE, BISHOP_TABLE, KNIGHT_TABLE, ROOK_TABLE, QUEEN_TABLE, ENDGAME_KING_TABLE};
+    }
+
+    /**
+     * @brief Full recompute followed by the phase blend.
+     */
+    int Evaluation::Evaluate(const Position &position)
+    {
+        return Taper(ComputeScore(position));
+    }
+
+    /**
+     * @brief Sum the contribution of every piece on the board.
+     */
+    EvaluationScore Evaluation::ComputeScore(const Position &position)
+    {
+        EvaluationScore score;
+        for(int index = 0; index < PIECE_TYPE_COUNT; index++)
+        {
+            PieceType piece = Position::PieceAtIndex(index);
+            uint64_t pieces = position.GetPieceBitboard(piece);
+            while(pieces)
+            {
+                UpdateScore(score, piece, PopLowestSquare(pieces), 1);
+            }
+        }
+        return score;
+    }
+
+    /**
+     * @brief Material and table bonus of a piece, negative for black pieces.
+     *
+     * The tables are written from white's side; black pieces read them with
+     * the ranks mirrored.
+     */
+    void Evaluation::UpdateScore(EvaluationScore &score, PieceType piece, int square, int delta)
+    {
+        if(piece == PieceType::invalid) return;
+
+        bool white = Position::IsWhitePiece(piece);
+        int type = abs(static_cast<int>(piece));
+        int tableIndex = (white ? 7 - RankOf(square) : RankOf(square)) * 8 + FileOf(square);
+        int sign = white ? delta : -delta;
+
+        score.mMiddlegame += sign * (PIECE_VALUES[type] + PIECE_TABLES[type][tableIndex]);
+        score.mEndgame += sign * (ENDGAME_PIECE_VALUES[type] + ENDGAME_PIECE_TABLES[type][tableIndex]);
+        score.mPhase += delta * PHASE_WEIGHTS[type];
+    }
+
+    /**
+     * @brief Linear blend; promotions can push the phase past the maximum, so it is clamped.
+     */
+    int Evaluation::Taper(const EvaluationScore &score)
+    {
+        int phase = std::min(std::max(score.mPhase, 0), MAX_PHASE);
+        return (score.mMiddlegame * phase + score.mEndgame * (MAX_PHASE - phase)) / MAX_PHASE;
+    }
+
+    /**
+     * @brief Look up the material value of a piece.
+     */
+    int Evaluation::GetPieceValue(PieceType piece)
+    {
+        return PIECE_VALUES[abs(static_cast<int>(piece))];
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file MappedFile.cpp
+ * @brief POSIX mmap implementation of `MappedFile`.
+ */
+#include"framework/MappedFile.h"
+
+#ifndef _WIN32
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+namespace chess
+{
+    MappedFile::MappedFile()
+        :mData{nullptr},
+        mSize{0}
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    /**
+     * @brief Map the whole file read-only and tell the kernel it is read front to back.
+     *
+     * The descriptor is closed right away; the mapping keeps the file alive.
+     */
+    bool MappedFile::Open(const std::string &path)
+    {
+        Close();
+#ifndef _WIN32
+        int file = open(path.c_str(), O_RDONLY);
+        if(file < 0)
+            return false;
+
+        struct stat status;
+        if(fstat(file, &status) != 0)
+        {
+            close(file);
+            return false;
+        }
+
+        size_t size = static_cast<size_t>(status.st_size);
+        if(size == 0)
+        {
+            // mmap rejects empty lengths; an empty file is simply empty
+            close(file);
+            return true;
+        }
+
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(data == MAP_FAILED)
+            return false;
+
+        madvise(data, size, MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(data);
+        mSize = size;
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    void MappedFile::Close()
+    {
+#ifndef _WIN32
+        if(mData)
+            munmap(const_cast<char*>(mData), mSize);
+#endif
+        mData = nullptr;
+        mSize = 0;
+    }
+}
@@ -0,0 +1,269 @@
+/**
+ * @file MoveGenerator.cpp
+ * @brief Bitboard legal move generation for `Position`.
+ */
+#include"framework/MoveGenerator.h"
+#include"framework/AttackTable.h"
+
+namespace chess
+{
+    /**
+     * @brief Every legal move.
+     */
+    void MoveGenerator::GenerateLegalMoves(const Position &position, MoveList &moves)
+    {
+        Generate(position, moves, false);
+    }
+
+    /**
+     * @brief Legal captures (including en passant) and promotions.
+     */
+    void MoveGenerator::GenerateLegalCaptures(const Position &position, MoveList &moves)
+    {
+        Generate(position, moves, true);
+    }
+
+    /**
+     * @brief Generate legal moves in one pass.
+     *
+     * King moves avoid every square the opponent attacks with the king lifted
+     * off the board. In double check only the king may move; in single check
+     * other pieces must capture the checker or block the checking ray. Pinned
+     * pieces stay on the line through their king and the pinner.
+     */
+    void MoveGenerator::Generate(const Position &position, MoveList &moves, bool capturesOnly)
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        bool white = position.IsWhiteToMove();
+        uint64_t king = position.GetPieceBitboard(white ? PieceType::whiteKing : PieceType::blackKing);
+        if(!king)
+            return;
+
+        int kingSquare = LowestSquare(king);
+        uint64_t occupancy = position.GetOccupancy();
+        uint64_t ownPieces = position.GetOccupancy(white);
+        uint64_t allowedTargets = capturesOnly ? position.GetOccupancy(!white) : ~ownPieces;
+
+        uint64_t kingDanger = position.GetAttacks(!white, occupancy ^ king);
+        AddMoves(kingSquare, attackTable.GetKingAttacks(kingSquare) & allowedTargets & ~kingDanger, moves);
+
+        uint64_t checkers = position.GetAttackersTo(kingSquare, !white, occupancy);
+        if(PopCount(checkers) > 1)
+            return;
+
+        MoveMasks masks;
+        masks.mKingSquare = kingSquare;
+        masks.mCheckMask = ~UINT64_C(0);
+        masks.mPinned = GetPinnedPieces(position, kingSquare);
+        masks.mCapturesOnly = capturesOnly;
+        if(checkers)
+        {
+            masks.mCheckMask = checkers | attackTable.GetBetween(kingSquare, LowestSquare(checkers));
+        }
+        else if(!capturesOnly)
+        {
+            GenerateCastlingMoves(position, kingDanger, moves);
+        }
+        masks.mTargets = allowedTargets & masks.mCheckMask;
+
+        GeneratePawnMoves(position, masks, moves);
+        GeneratePieceMoves(position, masks, moves);
+    }
+
+    /**
+     * @brief Look the move up in the legal move list.
+     */
+    bool MoveGenerator::IsLegalMove(const Position &position, Move move)
+    {
+        MoveList moves;
+        GenerateLegalMoves(position, moves);
+        return moves.Contains(move);
+    }
+
+    /**
+     * @brief Match the text against the legal moves, which carry the flags the text lacks.
+     */
+    Move MoveGenerator::ParseMove(const Position &position, const std::string &text)
+    {
+        MoveList moves;
+        GenerateLegalMoves(position, moves);
+        for(Move move : moves)
+        {
+            if(move.ToString() == text)
+                return move;
+        }
+        return Move{};
+    }
+
+    /**
+     * @brief Find enemy sliders that would attack the king through exactly one own piece.
+     */
+    uint64_t MoveGenerator::GetPinnedPieces(const Position &position, int kingSquare)
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        bool white = position.IsWhiteToMove();
+        uint64_t occupancy = position.GetOccupancy();
+        uint64_t ownPieces = position.GetOccupancy(white);
+        uint64_t enemyPieces = position.GetOccupancy(!white);
+        uint64_t queens = position.GetPieceBitboard(white ? PieceType::blackQueen : PieceType::whiteQueen);
+
+        // Sliders seen from the king when looking through own pieces
+        uint64_t snipers = (attackTable.GetRookAttacks(kingSquare, enemyPieces) & (position.GetPieceBitboard(white ? PieceType::blackRook : PieceType::whiteRook) | queens))
+            | (attackTable.GetBishopAttacks(kingSquare, enemyPieces) & (position.GetPieceBitboard(white ? PieceType::blackBishop : PieceType::whiteBishop) | queens));
+
+        uint64_t pinned = 0;
+        while(snipers)
+        {
+            uint64_t blockers = attackTable.GetBetween(kingSquare, PopLowestSquare(snipers)) & occupancy;
+            if(PopCount(blockers) == 1 && (blockers & ownPieces))
+                pinned |= blockers;
+        }
+        return pinned;
+    }
+
+    /**
+     * @brief A pinned piece may only move along the line through its king.
+     */
+    uint64_t MoveGenerator::PinFilter(const MoveMasks &masks, int from, uint64_t targets)
+    {
+        if(masks.mPinned & SquareBit(from))
+            return targets & AttackTable::Get().GetLine(masks.mKingSquare, from);
+        return targets;
+    }
+
+    /**
+     * @brief Pawn moves for the side to move.
+     *
+     * En passant can expose the king along the rank both pawns leave, which
+     * no pin mask describes, so those rare moves are verified by playing them
+     * on a copy of the position.
+     */
+    void MoveGenerator::GeneratePawnMoves(const Position &position, const MoveMasks &masks, MoveList &moves)
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        bool white = position.IsWhiteToMove();
+        uint64_t pawns = position.GetPieceBitboard(white ? PieceType::whitePawn : PieceType::blackPawn);
+        uint64_t empty = ~position.GetOccupancy();
+        uint64_t enemies = position.GetOccupancy(!white);
+        uint64_t promotionRank = white ? RANK_8_MASK : RANK_1_MASK;
+        uint64_t doublePushRank = white ? (RANK_1_MASK << 24) : (RANK_8_MASK >> 24);
+        int forward = white ? 8 : -8;
+        int enPassantSquare = position.GetEnPassantSquare();
+
+        while(pawns)
+        {
+            int from = PopLowestSquare(pawns);
+
+            // Pushes (only promotions when generating captures)
+            uint64_t pushes = SquareBit(from + forward) & empty;
+            if(masks.mCapturesOnly)
+                pushes &= promotionRank;
+            else if(pushes)
+                pushes |= (white ? pushes << 8 : pushes >> 8) & empty & doublePushRank;
+
+            uint64_t targets = PinFilter(masks, from, (pushes & masks.mCheckMask) | (attackTable.GetPawnAttacks(from, white) & enemies & masks.mTargets));
+            while(targets)
+            {
+                int to = PopLowestSquare(targets);
+                if(SquareBit(to) & promotionRank)
+                    AddPromotions(from, to, moves);
+                else
+                    moves.Add(Move{from, to});
+            }
+
+            if(enPassantSquare != NO_SQUARE && (attackTable.GetPawnAttacks(from, white) & SquareBit(enPassantSquare)))
+            {
+                Move enPassant{from, enPassantSquare, MoveFlag::EnPassant};
+                if(!position.MoveLeavesKingInCheck(enPassant))
+                    moves.Add(enPassant);
+            }
+        }
+    }
+
+    /**
+     * @brief Knight and slider moves masked by check and pin restrictions.
+     */
+    void MoveGenerator::GeneratePieceMoves(const Position &position, const MoveMasks &masks, MoveList &moves)
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        bool white = position.IsWhiteToMove();
+        uint64_t occupancy = position.GetOccupancy();
+
+        // A pinned knight can never stay on its pin line
+        uint64_t knights = position.GetPieceBitboard(white ? PieceType::whiteKnight : PieceType::blackKnight) & ~masks.mPinned;
+        while(knights)
+        {
+            int from = PopLowestSquare(knights);
+            AddMoves(from, attackTable.GetKnightAttacks(from) & masks.mTargets, moves);
+        }
+
+        uint64_t queens = position.GetPieceBitboard(white ? PieceType::whiteQueen : PieceType::blackQueen);
+
+        uint64_t diagonalSliders = position.GetPieceBitboard(white ? PieceType::whiteBishop : PieceType::blackBishop) | queens;
+        while(diagonalSliders)
+        {
+            int from = PopLowestSquare(diagonalSliders);
+            AddMoves(from, PinFilter(masks, from, attackTable.GetBishopAttacks(from, occupancy) & masks.mTargets), moves);
+        }
+
+        uint64_t orthogonalSliders = position.GetPieceBitboard(white ? PieceType::whiteRook : PieceType::blackRook) | queens;
+        while(orthogonalSliders)
+        {
+            int from = PopLowestSquare(orthogonalSliders);
+            AddMoves(from, PinFilter(masks, from, attackTable.GetRookAttacks(from, occupancy) & masks.mTargets), moves);
+        }
+    }
+
+    /**
+     * @brief Append a plain move for every set bit of `targets`.
+     */
+    void MoveGenerator::AddMoves(int from, uint64_t targets, MoveList &moves)
+    {
+        while(targets)
+        {
+            moves.Add(Move{from, PopLowestSquare(targets)});
+        }
+    }
+
+    /**
+     * @brief Append queen, rook, bishop and knight promotions.
+     */
+    void MoveGenerator::AddPromotions(int from, int to, MoveList &moves)
+    {
+        moves.Add(Move{from, to, MoveFlag::Promotion, PieceType::whiteQueen});
+        moves.Add(Move{from, to, MoveFlag::Promotion, PieceType::whiteRook});
+        moves.Add(Move{from, to, MoveFlag::Promotion, PieceType::whiteBishop});
+        moves.Add(Move{from, to, MoveFlag::Promotion, PieceType::whiteKnight});
+    }
+
+    /**
+     * @brief Castling requires the right, empty squares between king and rook,
+     * and a king that does not cross or land on an attacked square.
+     *
+     * Only called when the king is not in check.
+     */
+    void MoveGenerator::GenerateCastlingMoves(const Position &position, uint64_t kingDanger, MoveList &moves)
+    {
+        bool white = position.IsWhiteToMove();
+        int backRank = white ? 1 : 8;
+        uint8_t kingSide = white ? CASTLE_WHITE_KING_SIDE : CASTLE_BLACK_KING_SIDE;
+        uint8_t queenSide = white ? CASTLE_WHITE_QUEEN_SIDE : CASTLE_BLACK_QUEEN_SIDE;
+        if(!(position.GetCastlingRights() & (kingSide | queenSide)))
+            return;
+
+        int kingSquare = ToSquare(backRank, 'e');
+        uint64_t occupancy = position.GetOccupancy();
+
+        uint64_t kingSidePath = SquareBit(ToSquare(backRank, 'f')) | SquareBit(ToSquare(backRank, 'g'));
+        if(position.HasCastlingRight(kingSide) && !(occupancy & kingSidePath) && !(kingDanger & kingSidePath))
+        {
+            moves.Add(Move{kingSquare, ToSquare(backRank, 'g'), MoveFlag::Castling});
+        }
+
+        uint64_t queenSidePath = SquareBit(ToSquare(backRank, 'c')) | SquareBit(ToSquare(backRank, 'd'));
+        if(position.HasCastlingRight(queenSide) && !(occupancy & (queenSidePath | SquareBit(ToSquare(backRank, 'b')))) && !(kingDanger & queenSidePath))
+        {
+            moves.Add(Move{kingSquare, ToSquare(backRank, 'c'), MoveFlag::Castling});
+        }
+    }
+}
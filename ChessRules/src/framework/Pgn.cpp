@@ -0,0 +1,418 @@
+/**
+ * @file Pgn.cpp
+ * @brief PGN tokenizer, game reader and export-format writer.
+ */
+#include"framework/Pgn.h"
+#include"framework/ChessState.h"
+#include"framework/San.h"
+#include<charconv>
+#include<ostream>
+
+namespace chess
+{
+    namespace
+    {
+        /** @brief Export format keeps movetext lines below 80 characters. */
+        constexpr size_t MAX_LINE_LENGTH = 79;
+
+        bool IsSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+        }
+
+        /** @brief Characters that end a movetext token besides whitespace. */
+        bool IsDelimiter(char c)
+        {
+            return IsSpace(c) || c == '{' || c == '}' || c == '(' || c == ')' || c == '[' || c == ']' || c == ';' || c == '$';
+        }
+
+        bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        bool IsResult(std::string_view token)
+        {
+            return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+        }
+
+        /**
+         * @brief Movetext output that wraps between tokens.
+         */
+        struct MovetextWriter
+        {
+            std::ostream& mOutput;
+            size_t mColumn;
+
+            void WriteToken(const char* text, size_t length)
+            {
+                if(mColumn > 0 && mColumn + 1 + length > MAX_LINE_LENGTH)
+                {
+                    mOutput.put('\n');
+                    mColumn = 0;
+                }
+                else if(mColumn > 0)
+                {
+                    mOutput.put(' ');
+                    mColumn++;
+                }
+                mOutput.write(text, static_cast<std::streamsize>(length));
+                mColumn += length;
+            }
+
+            /** @brief "$n", then "{comment}" wrapped between its words. */
+            void WriteAnnotation(const PgnAnnotation& annotation)
+            {
+                if(annotation.mNag > 0)
+                {
+                    char buffer[8] = {'$'};
+                    size_t length = static_cast<size_t>(std::to_chars(buffer + 1, buffer + sizeof(buffer), annotation.mNag).ptr - buffer);
+                    WriteToken(buffer, length);
+                }
+                if(annotation.mComment.empty())
+                    return;
+
+                // Words are written with the opening and closing braces glued on
+                std::string_view comment = annotation.mComment;
+                std::string word;
+                size_t start = 0;
+                while(start <= comment.size())
+                {
+                    size_t end = comment.find(' ', start);
+                    if(end == std::string_view::npos)
+                        end = comment.size();
+                    word.assign(start == 0 ? "{" : "");
+                    word.append(comment.substr(start, end - start));
+                    if(end == comment.size())
+                        word.push_back('}');
+                    WriteToken(word.data(), word.size());
+                    start = end + 1;
+                }
+            }
+
+            /** @brief "12." before a white move, "12..." before a black one. */
+            void WriteMoveNumber(int number, bool white)
+            {
+                char buffer[16];
+                size_t length = static_cast<size_t>(std::to_chars(buffer, buffer + 12, number).ptr - buffer);
+                buffer[length++] = '.';
+                if(!white)
+                {
+                    buffer[length++] = '.';
+                    buffer[length++] = '.';
+                }
+                WriteToken(buffer, length);
+            }
+        };
+    }
+
+    std::string_view PgnGame::GetTag(std::string_view name) const
+    {
+        for(const PgnTag& tag : mTags)
+        {
+            if(tag.mName == name)
+                return tag.mValue;
+        }
+        return std::string_view{};
+    }
+
+    void PgnGame::Clear()
+    {
+        mTags.clear();
+        mStartPosition.ResetToStartPosition();
+        mMoves.clear();
+        mResult = std::string_view{};
+        mTruncated = false;
+        mAnnotations.clear();
+    }
+
+    PgnReader::PgnReader(std::string_view text)
+        :mText{text},
+        mOffset{0}
+    {
+    }
+
+    /**
+     * @brief Tags first, then movetext up to the result.
+     *
+     * A game without a result token ends where the next tag section
+     * starts or at the end of the text.
+     */
+    bool PgnReader::ReadGame(PgnGame &game)
+    {
+        game.Clear();
+
+        SkipSeparators();
+        if(mOffset >= mText.size())
+            return false;
+
+        while(mOffset < mText.size() && mText[mOffset] == '[')
+        {
+            ReadTag(game);
+            SkipSeparators();
+        }
+
+        std::string_view fen = game.GetTag("FEN");
+        if(!fen.empty() && !game.mStartPosition.SetFromFen(fen))
+            game.mTruncated = true;
+
+        Position position = game.mStartPosition;
+        while(true)
+        {
+            SkipSeparators();
+            if(mOffset >= mText.size() || mText[mOffset] == '[')
+                break;
+
+            char c = mText[mOffset];
+            if(c == '$')
+            {
+                // Numeric annotation glyph
+                mOffset++;
+                while(mOffset < mText.size() && IsDigit(mText[mOffset]))
+                    mOffset++;
+                continue;
+            }
+            if(IsDelimiter(c))
+            {
+                // Stray ')', '}' or ']'
+                mOffset++;
+                continue;
+            }
+
+            std::string_view token = ReadToken();
+            if(IsResult(token))
+            {
+                game.mResult = token;
+                break;
+            }
+
+            // Move number ("12." or "12..."), possibly glued to the move ("12.e4")
+            size_t digits = 0;
+            while(digits < token.size() && IsDigit(token[digits]))
+                digits++;
+            if(digits > 0 && digits < token.size() && token[digits] == '.')
+            {
+                token.remove_prefix(digits);
+                while(!token.empty() && token.front() == '.')
+                    token.remove_prefix(1);
+                if(token.empty())
+                    continue;
+            }
+            else if(digits == token.size())
+            {
+                // Move number written without a period
+                continue;
+            }
+
+            if(game.mTruncated)
+                continue;
+
+            Move move = San::Parse(position, token);
+            if(!move.IsValid())
+            {
+                game.mTruncated = true;
+                continue;
+            }
+            UndoRecord undo;
+            position.MakeMove(move, undo);
+            game.mMoves.push_back(move);
+        }
+        return true;
+    }
+
+    void PgnReader::SkipSeparators()
+    {
+        while(mOffset < mText.size())
+        {
+            if(IsSpace(mText[mOffset]))
+                mOffset++;
+            else if(!SkipAnnotation())
+                break;
+        }
+    }
+
+    /**
+     * @brief Variations may nest and contain comments, which may contain parentheses.
+     */
+    bool PgnReader::SkipAnnotation()
+    {
+        char c = mText[mOffset];
+        if(c == '{')
+        {
+            SkipPast('}');
+        }
+        else if(c == ';' || (c == '%' && (mOffset == 0 || mText[mOffset - 1] == '\n')))
+        {
+            SkipPast('\n');
+        }
+        else if(c == '(')
+        {
+            int depth = 0;
+            while(mOffset < mText.size())
+            {
+                c = mText[mOffset];
+                if(c == '{' || c == ';')
+                {
+                    SkipPast(c == '{' ? '}' : '\n');
+                    continue;
+                }
+                mOffset++;
+                if(c == '(')
+                    depth++;
+                else if(c == ')' && --depth == 0)
+                    break;
+            }
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief `[Name "Value"]`, with `\"` and `\\` allowed inside the value.
+     */
+    void PgnReader::ReadTag(PgnGame &game)
+    {
+        size_t lineStart = mOffset;
+        auto skipSpaces = [this]()
+        {
+            while(mOffset < mText.size() && (mText[mOffset] == ' ' || mText[mOffset] == '\t'))
+                mOffset++;
+        };
+
+        mOffset++;
+        skipSpaces();
+        size_t nameStart = mOffset;
+        while(mOffset < mText.size() && !IsSpace(mText[mOffset]) && mText[mOffset] != '"' && mText[mOffset] != ']')
+            mOffset++;
+        std::string_view name = mText.substr(nameStart, mOffset - nameStart);
+        skipSpaces();
+
+        if(name.empty() || mOffset >= mText.size() || mText[mOffset] != '"')
+        {
+            mOffset = lineStart;
+            SkipPast('\n');
+            return;
+        }
+
+        size_t valueStart = ++mOffset;
+        while(mOffset < mText.size() && mText[mOffset] != '"' && mText[mOffset] != '\n')
+        {
+            if(mText[mOffset] == '\\' && mOffset + 1 < mText.size())
+                mOffset++;
+            mOffset++;
+        }
+        if(mOffset >= mText.size() || mText[mOffset] != '"')
+        {
+            mOffset = lineStart;
+            SkipPast('\n');
+            return;
+        }
+        std::string_view value = mText.substr(valueStart, mOffset - valueStart);
+        mOffset++;
+        skipSpaces();
+        if(mOffset < mText.size() && mText[mOffset] == ']')
+            mOffset++;
+
+        game.mTags.push_back(PgnTag{name, value});
+    }
+
+    std::string_view PgnReader::ReadToken()
+    {
+        size_t start = mOffset;
+        while(mOffset < mText.size() && !IsDelimiter(mText[mOffset]))
+            mOffset++;
+        return mText.substr(start, mOffset - start);
+    }
+
+    void PgnReader::SkipPast(char end)
+    {
+        while(mOffset < mText.size() && mText[mOffset] != end)
+            mOffset++;
+        if(mOffset < mText.size())
+            mOffset++;
+    }
+
+    /**
+     * @brief Replay the moves on a copy of the start position to write each in SAN.
+     */
+    void PgnWriter::Write(std::ostream &output, const PgnGame &game)
+    {
+        for(const PgnTag& tag : game.mTags)
+        {
+            output << '[' << tag.mName << " \"" << tag.mValue << "\"]\n";
+        }
+        output << '\n';
+
+        MovetextWriter movetext{output, 0};
+        Position position = game.mStartPosition;
+        int moveNumber = position.GetFullMoveNumber();
+        // Black's move is numbered "12..." at the start and after a comment
+        bool numberBlack = true;
+        for(size_t i = 0; i < game.mMoves.size(); i++)
+        {
+            Move move = game.mMoves[i];
+            bool white = position.IsWhiteToMove();
+            if(white || numberBlack)
+                movetext.WriteMoveNumber(moveNumber, white);
+
+            char san[San::MAX_SAN_LENGTH];
+            movetext.WriteToken(san, San::Write(position, move, san));
+            numberBlack = false;
+            if(i < game.mAnnotations.size())
+            {
+                movetext.WriteAnnotation(game.mAnnotations[i]);
+                numberBlack = !game.mAnnotations[i].mComment.empty();
+            }
+
+            UndoRecord undo;
+            position.MakeMove(move, undo);
+            if(!white)
+                moveNumber++;
+        }
+
+        std::string_view result = game.mResult.empty() ? std::string_view{"*"} : game.mResult;
+        movetext.WriteToken(result.data(), result.size());
+        output << "\n\n";
+    }
+
+    /**
+     * @brief Build a `PgnGame` around the state's start position and history.
+     */
+    void PgnWriter::Write(std::ostream &output, const ChessState &state)
+    {
+        PgnGame game;
+        game.mStartPosition = state.GetStartPosition();
+        game.mMoves = state.GetMovesPlayed();
+        game.mResult = ResultOf(state.GetGameState());
+
+        std::string fen = game.mStartPosition.GetFen();
+        game.mTags.push_back(PgnTag{"Event", "?"});
+        game.mTags.push_back(PgnTag{"Site", "?"});
+        game.mTags.push_back(PgnTag{"Date", "????.??.??"});
+        game.mTags.push_back(PgnTag{"Round", "?"});
+        game.mTags.push_back(PgnTag{"White", "?"});
+        game.mTags.push_back(PgnTag{"Black", "?"});
+        game.mTags.push_back(PgnTag{"Result", game.mResult});
+        if(fen != Position::START_FEN)
+        {
+            game.mTags.push_back(PgnTag{"SetUp", "1"});
+            game.mTags.push_back(PgnTag{"FEN", fen});
+        }
+
+        Write(output, game);
+    }
+
+    std::string_view PgnWriter::ResultOf(GameState state)
+    {
+        switch(state)
+        {
+        case GameState::WhiteWon: return "1-0";
+        case GameState::BlackWon: return "0-1";
+        case GameState::Draw: return "1/2-1/2";
+        default: return "*";
+        }
+    }
+}
@@ -0,0 +1,657 @@
+/**
+ * @file Position.cpp
+ * @brief Implementation of the copyable position, make/unmake and attack queries.
+ */
+#include"framework/Position.h"
+#include"framework/AttackTable.h"
+#include"framework/Zobrist.h"
+#include<cstdlib>
+
+namespace chess
+{
+    /**
+     * @brief Construct an empty position.
+     */
+    Position::Position()
+        :mPieces{},
+        mOccupancy{},
+        mWhiteToMove{true},
+        mCastlingRights{0},
+        mEnPassantSquare{NO_SQUARE},
+        mHalfMoveClock{0},
+        mFullMoveNumber{1},
+        mHash{0}
+    {
+    }
+
+    /**
+     * @brief Set up the standard initial position with all castling rights.
+     */
+    void Position::ResetToStartPosition()
+    {
+        SetFromFen(START_FEN);
+    }
+
+    /**
+     * @brief Empty the board and reset side to move, rights and clocks.
+     */
+    void Position::Clear()
+    {
+        *this = Position{};
+    }
+
+    namespace
+    {
+        /** @brief Piece of a FEN placement letter, 'invalid' for anything else. */
+        PieceType PieceFromFenChar(char c)
+        {
+            switch(c)
+            {
+            case 'P': return PieceType::whitePawn;
+            case 'B': return PieceType::whiteBishop;
+            case 'N': return PieceType::whiteKnight;
+            case 'R': return PieceType::whiteRook;
+            case 'Q': return PieceType::whiteQueen;
+            case 'K': return PieceType::whiteKing;
+            case 'p': return PieceType::blackPawn;
+            case 'b': return PieceType::blackBishop;
+            case 'n': return PieceType::blackKnight;
+            case 'r': return PieceType::blackRook;
+            case 'q': return PieceType::blackQueen;
+            case 'k': return PieceType::blackKing;
+            default: return PieceType::invalid;
+            }
+        }
+
+        /** @brief FEN letter of a piece: upper case for white. */
+        char FenCharOfPiece(PieceType piece)
+        {
+            int value = static_cast<int>(piece);
+            return value > 0 ? "PBNRQK"[value - 1] : "pbnrqk"[-value - 1];
+        }
+
+        /** @brief Skip spaces, then return the next space-delimited field (empty at the end). */
+        std::string_view NextField(std::string_view text, size_t& index)
+        {
+            while(index < text.size() && text[index] == ' ')
+                index++;
+            size_t start = index;
+            while(index < text.size() && text[index] != ' ')
+                index++;
+            return text.substr(start, index - start);
+        }
+
+        /** @brief Parse a non-negative decimal number; false if the field is not one or overflows. */
+        bool ParseCounter(std::string_view field, int& value)
+        {
+            if(field.empty() || field.size() > 5)
+                return false;
+            value = 0;
+            for(char c : field)
+            {
+                if(c < '0' || c > '9')
+                    return false;
+                value = value * 10 + (c - '0');
+            }
+            return value <= UINT16_MAX;
+        }
+
+        /** @brief Append a non-negative number to a character buffer. */
+        char* WriteCounter(char* out, int value)
+        {
+            char digits[8];
+            int count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while(value > 0);
+            while(count > 0)
+                *out++ = digits[--count];
+            return out;
+        }
+    }
+
+    /**
+     * @brief Parse the FEN fields one after the other.
+     *
+     * Works on a view of the text and writes the bitboards directly, so
+     * loading a position allocates nothing; the key is computed once at the
+     * end.
+     */
+    bool Position::SetFromFen(std::string_view fen)
+    {
+        Clear();
+
+        size_t index = 0;
+        std::string_view placement = NextField(fen, index);
+        std::string_view side = NextField(fen, index);
+        std::string_view castling = NextField(fen, index);
+        std::string_view enPassant = NextField(fen, index);
+        std::string_view halfMoveField = NextField(fen, index);
+        std::string_view fullMoveField = NextField(fen, index);
+        if(enPassant.empty())
+            return false;
+
+        // Placement runs from rank 8 down to rank 1, files 'a' to 'h'
+        int rank = 8;
+        char file = 'a';
+        bool valid = true;
+        for(char c : placement)
+        {
+            if(c == '/')
+            {
+                if(file != 'h' + 1 || rank == 1) { valid = false; break; }
+                rank--;
+                file = 'a';
+            }
+            else if(c >= '1' && c <= '8')
+            {
+                file += c - '0';
+                if(file > 'h' + 1) { valid = false; break; }
+            }
+            else
+            {
+                PieceType piece = PieceFromFenChar(c);
+                if(piece == PieceType::invalid || file > 'h') { valid = false; break; }
+                uint64_t bit = SquareBit(ToSquare(rank, file));
+                mPieces[PieceIndex(piece)] |= bit;
+                mOccupancy[IsWhitePiece(piece) ? 0 : 1] |= bit;
+                file++;
+            }
+        }
+
+        valid = valid && rank == 1 && file == 'h' + 1
+            && PopCount(GetPieceBitboard(PieceType::whiteKing)) == 1 && PopCount(GetPieceBitboard(PieceType::blackKing)) == 1
+            && (side == "w" || side == "b");
+
+        if(castling != "-")
+        {
+            for(char c : castling)
+            {
+                switch(c)
+                {
+                case 'K': mCastlingRights |= CASTLE_WHITE_KING_SIDE; break;
+                case 'Q': mCastlingRights |= CASTLE_WHITE_QUEEN_SIDE; break;
+                case 'k': mCastlingRights |= CASTLE_BLACK_KING_SIDE; break;
+                case 'q': mCastlingRights |= CASTLE_BLACK_QUEEN_SIDE; break;
+                default: valid = false;
+                }
+            }
+        }
+
+        // A right is only kept while its king and rook are still on their home squares
+        auto onSquare = [this](PieceType piece, int rank, char file) {
+            return (GetPieceBitboard(piece) & SquareBit(ToSquare(rank, file))) != 0;
+        };
+        if(!onSquare(PieceType::whiteKing, 1, 'e'))
+            mCastlingRights &= ~(CASTLE_WHITE_KING_SIDE | CASTLE_WHITE_QUEEN_SIDE);
+        if(!onSquare(PieceType::whiteRook, 1, 'h'))
+            mCastlingRights &= ~CASTLE_WHITE_KING_SIDE;
+        if(!onSquare(PieceType::whiteRook, 1, 'a'))
+            mCastlingRights &= ~CASTLE_WHITE_QUEEN_SIDE;
+        if(!onSquare(PieceType::blackKing, 8, 'e'))
+            mCastlingRights &= ~(CASTLE_BLACK_KING_SIDE | CASTLE_BLACK_QUEEN_SIDE);
+        if(!onSquare(PieceType::blackRook, 8, 'h'))
+            mCastlingRights &= ~CASTLE_BLACK_KING_SIDE;
+        if(!onSquare(PieceType::blackRook, 8, 'a'))
+            mCastlingRights &= ~CASTLE_BLACK_QUEEN_SIDE;
+
+        // The target must be the square a pawn of the side that just moved
+        // skipped: empty, with that pawn in front of it and its origin empty
+        if(enPassant != "-")
+        {
+            bool whiteToMove = side == "w";
+            ChessCoordinate target{enPassant.size() == 2 ? enPassant[1] - '0' : -1, enPassant[0]};
+            if(!target.isValid() || target.rank != (whiteToMove ? 6 : 3))
+            {
+                valid = false;
+            }
+            else
+            {
+                int square = ToSquare(target);
+                int pawnSquare = whiteToMove ? square - 8 : square + 8;
+                int originSquare = whiteToMove ? square + 8 : square - 8;
+                PieceType pushedPawn = whiteToMove ? PieceType::blackPawn : PieceType::whitePawn;
+                uint64_t occupancy = GetOccupancy();
+                if(!(GetPieceBitboard(pushedPawn) & SquareBit(pawnSquare))
+                    || (occupancy & (SquareBit(square) | SquareBit(originSquare))))
+                    valid = false;
+                else if(CanCaptureEnPassant(square, whiteToMove))
+                    mEnPassantSquare = static_cast<int8_t>(square);
+            }
+        }
+
+        // Both counters are optional; a present one must be a number
+        int halfMoveClock = 0, fullMoveNumber = 1;
+        if(!halfMoveField.empty() && !ParseCounter(halfMoveField, halfMoveClock))
+            valid = false;
+        if(!fullMoveField.empty() && (!ParseCounter(fullMoveField, fullMoveNumber) || fullMoveNumber < 1))
+            valid = false;
+
+        // The side that just moved cannot have left its own king attacked
+        mWhiteToMove = side == "w";
+        if(valid && IsInCheck(!mWhiteToMove))
+            valid = false;
+
+        if(!valid)
+        {
+            Clear();
+            return false;
+        }
+
+        mHalfMoveClock = static_cast<uint16_t>(halfMoveClock);
+        mFullMoveNumber = static_cast<uint16_t>(fullMoveNumber);
+        mHash = ComputeHash();
+        return true;
+    }
+
+    /**
+     * @brief Serialize into a stack buffer, building the string once.
+     */
+    std::string Position::GetFen() const
+    {
+        char buffer[MAX_FEN_LENGTH];
+        char* out = buffer;
+
+        for(int rank = 8; rank >= 1; rank--)
+        {
+            int empty = 0;
+            for(char file = 'a'; file <= 'h'; file++)
+            {
+                PieceType piece = GetPieceOnSquare(ToSquare(rank, file));
+                if(piece == PieceType::invalid)
+                {
+                    empty++;
+                    continue;
+                }
+                if(empty > 0)
+                    *out++ = static_cast<char>('0' + empty);
+                empty = 0;
+                *out++ = FenCharOfPiece(piece);
+            }
+            if(empty > 0)
+                *out++ = static_cast<char>('0' + empty);
+            if(rank > 1)
+                *out++ = '/';
+        }
+
+        *out++ = ' ';
+        *out++ = mWhiteToMove ? 'w' : 'b';
+        *out++ = ' ';
+        if(mCastlingRights == 0)
+        {
+            *out++ = '-';
+        }
+        else
+        {
+            if(mCastlingRights & CASTLE_WHITE_KING_SIDE) *out++ = 'K';
+            if(mCastlingRights & CASTLE_WHITE_QUEEN_SIDE) *out++ = 'Q';
+            if(mCastlingRights & CASTLE_BLACK_KING_SIDE) *out++ = 'k';
+            if(mCastlingRights & CASTLE_BLACK_QUEEN_SIDE) *out++ = 'q';
+        }
+        *out++ = ' ';
+        if(mEnPassantSquare == NO_SQUARE)
+        {
+            *out++ = '-';
+        }
+        else
+        {
+            ChessCoordinate target = ToChessCoordinate(mEnPassantSquare);
+            *out++ = target.file;
+            *out++ = static_cast<char>('0' + target.rank);
+        }
+        *out++ = ' ';
+        out = WriteCounter(out, mHalfMoveClock);
+        *out++ = ' ';
+        out = WriteCounter(out, mFullMoveNumber);
+        return std::string{buffer, static_cast<size_t>(out - buffer)};
+    }
+
+    /**
+     * @brief Query the piece occupying a square.
+     * @return Piece identifier at the square, or `invalid` if empty.
+     */
+    PieceType Position::GetPieceOnSquare(int square) const
+    {
+        uint64_t bit = SquareBit(square);
+        if(!(GetOccupancy() & bit)) return PieceType::invalid;
+
+        int first = (mOccupancy[0] & bit) ? 0 : 6;
+        for(int i = first; i < first + 6; i++)
+        {
+            if(mPieces[i] & bit) return PieceAtIndex(i);
+        }
+        return PieceType::invalid;
+    }
+
+    /**
+     * @brief Set the bit for a piece on a square.
+     */
+    void Position::SpawnPiece(PieceType piece, int square)
+    {
+        if(piece == PieceType::invalid) return;
+        uint64_t bit = SquareBit(square);
+        if(GetOccupancy() & bit) return;
+        mPieces[PieceIndex(piece)] |= bit;
+        mOccupancy[IsWhitePiece(piece) ? 0 : 1] |= bit;
+        mHash ^= Zobrist::Get().GetPieceKey(PieceIndex(piece), square);
+    }
+
+    /**
+     * @brief Clear the bit for a piece on a square.
+     */
+    void Position::RemovePiece(PieceType piece, int square)
+    {
+        if(piece == PieceType::invalid) return;
+        uint64_t bit = SquareBit(square);
+        if(!(mPieces[PieceIndex(piece)] & bit)) return;
+        mPieces[PieceIndex(piece)] ^= bit;
+        mOccupancy[IsWhitePiece(piece) ? 0 : 1] ^= bit;
+        mHash ^= Zobrist::Get().GetPieceKey(PieceIndex(piece), square);
+    }
+
+    /**
+     * @brief Derive the move flag from the pieces involved.
+     */
+    Move Position::BuildMove(int from, int to, PieceType promotion) const
+    {
+        PieceType piece = GetPieceOnSquare(from);
+
+        if(piece == PieceType::whitePawn || piece == PieceType::blackPawn)
+        {
+            if(RankOf(to) == 0 || RankOf(to) == 7)
+            {
+                if(promotion == PieceType::invalid) promotion = PieceType::whiteQueen;
+                return Move{from, to, MoveFlag::Promotion, promotion};
+            }
+            if(to == mEnPassantSquare)
+            {
+                return Move{from, to, MoveFlag::EnPassant};
+            }
+        }
+        else if((piece == PieceType::whiteKing || piece == PieceType::blackKing) && abs(FileOf(to) - FileOf(from)) == 2)
+        {
+            return Move{from, to, MoveFlag::Castling};
+        }
+        return Move{from, to};
+    }
+
+    /**
+     * @brief Play a move and record what is needed to take it back.
+     */
+    bool Position::MakeMove(Move move, UndoRecord &undo)
+    {
+        int from = move.GetFrom();
+        int to = move.GetTo();
+        PieceType piece = GetPieceOnSquare(from);
+        if(piece == PieceType::invalid || from == to) return false;
+
+        bool white = IsWhitePiece(piece);
+        bool pawn = piece == PieceType::whitePawn || piece == PieceType::blackPawn;
+
+        undo.mMove = move;
+        undo.mMovedPiece = piece;
+        undo.mEnPassantSquare = mEnPassantSquare;
+        undo.mCastlingRights = mCastlingRights;
+        undo.mHalfMoveClock = mHalfMoveClock;
+        undo.mHash = mHash;
+
+        // En passant captures the pawn behind the target square
+        int capturedSquare = move.GetFlag() == MoveFlag::EnPassant ? (white ? to - 8 : to + 8) : to;
+        PieceType captured = GetPieceOnSquare(capturedSquare);
+        undo.mCapturedPiece = captured;
+        if(captured != PieceType::invalid)
+        {
+            RemovePiece(captured, capturedSquare);
+        }
+
+        RemovePiece(piece, from);
+        SpawnPiece(move.GetFlag() == MoveFlag::Promotion ? move.GetPromotion(white) : piece, to);
+
+        if(move.GetFlag() == MoveFlag::Castling)
+        {
+            bool kingSide = FileOf(to) > FileOf(from);
+            int backRank = RankOf(from) + 1;
+            PieceType rook = white ? PieceType::whiteRook : PieceType::blackRook;
+            RemovePiece(rook, ToSquare(backRank, kingSide ? 'h' : 'a'));
+            SpawnPiece(rook, ToSquare(backRank, kingSide ? 'f' : 'd'));
+        }
+
+        // Pieces were hashed by Remove/SpawnPiece; swap the keys of the rest of the state
+        const Zobrist& zobrist = Zobrist::Get();
+        mHash ^= zobrist.GetCastlingKey(mCastlingRights) ^ zobrist.GetEnPassantKey(mEnPassantSquare) ^ zobrist.GetSideKey();
+
+        mCastlingRights &= ~(CastlingRightsLost(from) | CastlingRightsLost(to));
+        // Only record the target when a pawn can take on it, so transpositions share a key
+        int passedSquare = (from + to) / 2;
+        mEnPassantSquare = (pawn && abs(to - from) == 16 && CanCaptureEnPassant(passedSquare, !white))
+            ? static_cast<int8_t>(passedSquare) : NO_SQUARE;
+        mHalfMoveClock = (pawn || captured != PieceType::invalid) ? 0 : mHalfMoveClock + 1;
+        if(!white) mFullMoveNumber++;
+        mWhiteToMove = !white;
+
+        mHash ^= zobrist.GetCastlingKey(mCastlingRights) ^ zobrist.GetEnPassantKey(mEnPassantSquare);
+        VerifyHash();
+        return true;
+    }
+
+    /**
+     * @brief A pawn attacks the square exactly when a pawn of the other colour there would attack it.
+     */
+    bool Position::CanCaptureEnPassant(int square, bool byWhite) const
+    {
+        return (AttackTable::Get().GetPawnAttacks(square, !byWhite) & GetPieceBitboard(byWhite ? PieceType::whitePawn : PieceType::blackPawn)) != 0;
+    }
+
+    /**
+     * @brief Restore the position from before the move in `undo`.
+     */
+    void Position::UnmakeMove(const UndoRecord &undo)
+    {
+        Move move = undo.mMove;
+        int from = move.GetFrom();
+        int to = move.GetTo();
+        bool white = IsWhitePiece(undo.mMovedPiece);
+
+        RemovePiece(move.GetFlag() == MoveFlag::Promotion ? move.GetPromotion(white) : undo.mMovedPiece, to);
+        SpawnPiece(undo.mMovedPiece, from);
+
+        if(move.GetFlag() == MoveFlag::Castling)
+        {
+            bool kingSide = FileOf(to) > FileOf(from);
+            int backRank = RankOf(from) + 1;
+            PieceType rook = white ? PieceType::whiteRook : PieceType::blackRook;
+            RemovePiece(rook, ToSquare(backRank, kingSide ? 'f' : 'd'));
+            SpawnPiece(rook, ToSquare(backRank, kingSide ? 'h' : 'a'));
+        }
+
+        if(undo.mCapturedPiece != PieceType::invalid)
+        {
+            int capturedSquare = move.GetFlag() == MoveFlag::EnPassant ? (white ? to - 8 : to + 8) : to;
+            SpawnPiece(undo.mCapturedPiece, capturedSquare);
+        }
+
+        mCastlingRights = undo.mCastlingRights;
+        mEnPassantSquare = undo.mEnPassantSquare;
+        mHalfMoveClock = undo.mHalfMoveClock;
+        if(!white) mFullMoveNumber--;
+        mWhiteToMove = white;
+        mHash = undo.mHash;
+        VerifyHash();
+    }
+
+    /**
+     * @brief XOR together the keys of everything on the board.
+     */
+    uint64_t Position::ComputeHash() const
+    {
+        const Zobrist& zobrist = Zobrist::Get();
+        uint64_t hash = 0;
+
+        for(int index = 0; index < PIECE_TYPE_COUNT; index++)
+        {
+            uint64_t pieces = mPieces[index];
+            while(pieces)
+            {
+                hash ^= zobrist.GetPieceKey(index, PopLowestSquare(pieces));
+            }
+        }
+
+        hash ^= zobrist.GetCastlingKey(mCastlingRights) ^ zobrist.GetEnPassantKey(mEnPassantSquare);
+        if(!mWhiteToMove) hash ^= zobrist.GetSideKey();
+        return hash;
+    }
+
+    /**
+     * @brief Debug cross-check of the incremental Zobrist key.
+     *
+     * Compiled to nothing unless CHESS_VERIFY_HASH is defined, since the
+     * full recompute costs far more than the move itself.
+     */
+    void Position::VerifyHash() const
+    {
+    #if defined(CHESS_VERIFY_HASH)
+        if(mHash != ComputeHash())
+        {
+            LOG("Zobrist key diverged: incremental %016llx, recomputed %016llx",
+                static_cast<unsigned long long>(mHash), static_cast<unsigned long long>(ComputeHash()));
+            std::abort();
+        }
+    #endif
+    }
+
+    /**
+     * @brief Union of the attack tables of every piece of one side.
+     * @param white True for white pieces, false for black pieces.
+     * @param occupancy Blockers for the sliding pieces.
+     * @return Bitboard of attacked squares.
+     */
+    uint64_t Position::GetAttacks(bool white, uint64_t occupancy) const
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        uint64_t attacks = 0;
+
+        uint64_t pawns = GetPieceBitboard(white ? PieceType::whitePawn : PieceType::blackPawn);
+        while(pawns)
+        {
+            attacks |= attackTable.GetPawnAttacks(PopLowestSquare(pawns), white);
+        }
+
+        uint64_t knights = GetPieceBitboard(white ? PieceType::whiteKnight : PieceType::blackKnight);
+        while(knights)
+        {
+            attacks |= attackTable.GetKnightAttacks(PopLowestSquare(knights));
+        }
+
+        uint64_t queens = GetPieceBitboard(white ? PieceType::whiteQueen : PieceType::blackQueen);
+        uint64_t diagonalSliders = GetPieceBitboard(white ? PieceType::whiteBishop : PieceType::blackBishop) | queens;
+        while(diagonalSliders)
+        {
+            attacks |= attackTable.GetBishopAttacks(PopLowestSquare(diagonalSliders), occupancy);
+        }
+
+        uint64_t orthogonalSliders = GetPieceBitboard(white ? PieceType::whiteRook : PieceType::blackRook) | queens;
+        while(orthogonalSliders)
+        {
+            attacks |= attackTable.GetRookAttacks(PopLowestSquare(orthogonalSliders), occupancy);
+        }
+
+        uint64_t king = GetPieceBitboard(white ? PieceType::whiteKing : PieceType::blackKing);
+        if(king)
+        {
+            attacks |= attackTable.GetKingAttacks(LowestSquare(king));
+        }
+
+        return attacks;
+    }
+
+    /**
+     * @brief Check for attackers of a square by looking outwards from it.
+     *
+     * Cheaper than building the full attack map when only one square matters.
+     */
+    bool Position::IsSquareAttacked(int square, bool byWhite) const
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        uint64_t occupancy = GetOccupancy();
+        uint64_t queens = GetPieceBitboard(byWhite ? PieceType::whiteQueen : PieceType::blackQueen);
+
+        return (attackTable.GetPawnAttacks(square, !byWhite) & GetPieceBitboard(byWhite ? PieceType::whitePawn : PieceType::blackPawn))
+            || (attackTable.GetKnightAttacks(square) & GetPieceBitboard(byWhite ? PieceType::whiteKnight : PieceType::blackKnight))
+            || (attackTable.GetKingAttacks(square) & GetPieceBitboard(byWhite ? PieceType::whiteKing : PieceType::blackKing))
+            || (attackTable.GetBishopAttacks(square, occupancy) & (GetPieceBitboard(byWhite ? PieceType::whiteBishop : PieceType::blackBishop) | queens))
+            || (attackTable.GetRookAttacks(square, occupancy) & (GetPieceBitboard(byWhite ? PieceType::whiteRook : PieceType::blackRook) | queens));
+    }
+
+    /**
+     * @brief Look outwards from the square with every piece's attack pattern.
+     */
+    uint64_t Position::GetAttackersTo(int square, bool byWhite, uint64_t occupancy) const
+    {
+        const AttackTable& attackTable = AttackTable::Get();
+        uint64_t queens = GetPieceBitboard(byWhite ? PieceType::whiteQueen : PieceType::blackQueen);
+
+        return (attackTable.GetPawnAttacks(square, !byWhite) & GetPieceBitboard(byWhite ? PieceType::whitePawn : PieceType::blackPawn))
+            | (attackTable.GetKnightAttacks(square) & GetPieceBitboard(byWhite ? PieceType::whiteKnight : PieceType::blackKnight))
+            | (attackTable.GetKingAttacks(square) & GetPieceBitboard(byWhite ? PieceType::whiteKing : PieceType::blackKing))
+            | (attackTable.GetBishopAttacks(square, occupancy) & (GetPieceBitboard(byWhite ? PieceType::whiteBishop : PieceType::blackBishop) | queens))
+            | (attackTable.GetRookAttacks(square, occupancy) & (GetPieceBitboard(byWhite ? PieceType::whiteRook : PieceType::blackRook) | queens));
+    }
+
+    /**
+     * @brief Whether the given side's king is attacked.
+     */
+    bool Position::IsInCheck(bool white) const
+    {
+        uint64_t king = GetPieceBitboard(white ? PieceType::whiteKing : PieceType::blackKing);
+        return king && IsSquareAttacked(LowestSquare(king), !white);
+    }
+
+    /**
+     * @brief Try a move on a copy of this position.
+     * @return true if the moving side would be left in check (illegal move).
+     */
+    bool Position::MoveLeavesKingInCheck(Move move) const
+    {
+        Position copy = *this;
+        UndoRecord undo;
+        if(!copy.MakeMove(move, undo)) return true;
+        return copy.IsInCheck(IsWhitePiece(undo.mMovedPiece));
+    }
+
+    /**
+     * @brief Map a piece type to 0..5 (white) or 6..11 (black).
+     */
+    int Position::PieceIndex(PieceType piece)
+    {
+        int value = static_cast<int>(piece);
+        return value > 0 ? value - 1 : 5 - value;
+    }
+
+    /**
+     * @brief Inverse of `PieceIndex`.
+     */
+    PieceType Position::PieceAtIndex(int index)
+    {
+        return static_cast<PieceType>(index < 6 ? index + 1 : 5 - index);
+    }
+
+    /**
+     * @brief Rights that disappear when the king or a rook leaves its home
+     * square, or a rook is captured there.
+     */
+    uint8_t Position::CastlingRightsLost(int square)
+    {
+        switch(square)
+        {
+        case 3:  return CASTLE_WHITE_KING_SIDE | CASTLE_WHITE_QUEEN_SIDE; // e1
+        case 0:  return CASTLE_WHITE_KING_SIDE;                           // h1
+        case 7:  return CASTLE_WHITE_QUEEN_SIDE;                          // a1
+        case 59: return CASTLE_BLACK_KING_SIDE | CASTLE_BLACK_QUEEN_SIDE; // e8
+        case 56: return CASTLE_BLACK_KING_SIDE;                           // h8
+        case 63: return CASTLE_BLACK_QUEEN_SIDE;                          // a8
+        }
+        return 0;
+    }
+}
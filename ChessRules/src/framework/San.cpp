@@ -0,0 +1,188 @@
+/**
+ * @file San.cpp
+ * @brief SAN parsing and formatting against the legal moves.
+ */
+#include"framework/San.h"
+#include"framework/MoveGenerator.h"
+#include<cstdlib>
+
+namespace chess
+{
+    namespace
+    {
+        /** @brief Piece kind (1..6, colour dropped) of a SAN piece letter, 0 for anything else. */
+        int PieceKindOfLetter(char c)
+        {
+            switch(c)
+            {
+            case 'B': return 2;
+            case 'N': return 3;
+            case 'R': return 4;
+            case 'Q': return 5;
+            case 'K': return 6;
+            default: return 0;
+            }
+        }
+
+        /** @brief Piece kind (1..6) standing on a square, 0 if it is empty. */
+        int PieceKindOn(const Position& position, int square)
+        {
+            return abs(static_cast<int>(position.GetPieceOnSquare(square)));
+        }
+
+        bool IsFile(char c) { return c >= 'a' && c <= 'h'; }
+        bool IsRank(char c) { return c >= '1' && c <= '8'; }
+    }
+
+    /**
+     * @brief Take the text apart from the back (suffixes, promotion, target),
+     * then match what is left against every legal move.
+     */
+    Move San::Parse(const Position &position, std::string_view text)
+    {
+        while(!text.empty() && (text.back() == '+' || text.back() == '#' || text.back() == '!' || text.back() == '?'))
+            text.remove_suffix(1);
+        if(text.empty())
+            return Move{};
+
+        MoveList moves;
+        MoveGenerator::GenerateLegalMoves(position, moves);
+
+        if(text == "O-O" || text == "0-0" || text == "O-O-O" || text == "0-0-0")
+        {
+            char kingFile = text.size() == 3 ? 'g' : 'c';
+            for(Move move : moves)
+            {
+                if(move.GetFlag() == MoveFlag::Castling && ToChessCoordinate(move.GetTo()).file == kingFile)
+                    return move;
+            }
+            return Move{};
+        }
+
+        int pieceKind = PieceKindOfLetter(text.front());
+        if(pieceKind != 0)
+            text.remove_prefix(1);
+        else
+            pieceKind = 1;
+
+        int promotionKind = 0;
+        if(pieceKind == 1 && !text.empty() && PieceKindOfLetter(text.back()) != 0)
+        {
+            promotionKind = PieceKindOfLetter(text.back());
+            text.remove_suffix(1);
+            if(!text.empty() && text.back() == '=')
+                text.remove_suffix(1);
+        }
+
+        if(text.size() < 2 || !IsFile(text[text.size() - 2]) || !IsRank(text.back()))
+            return Move{};
+        int to = ToSquare(text.back() - '0', text[text.size() - 2]);
+        text.remove_suffix(2);
+
+        // Whatever remains is disambiguation plus an optional capture sign
+        char fromFile = 0, fromRank = 0;
+        for(char c : text)
+        {
+            if(IsFile(c)) fromFile = c;
+            else if(IsRank(c)) fromRank = c;
+            else if(c != 'x' && c != '-' && c != ':') return Move{};
+        }
+
+        bool white = position.IsWhiteToMove();
+        Move found{};
+        for(Move move : moves)
+        {
+            if(move.GetTo() != to || PieceKindOn(position, move.GetFrom()) != pieceKind)
+                continue;
+            ChessCoordinate from = ToChessCoordinate(move.GetFrom());
+            if((fromFile && from.file != fromFile) || (fromRank && from.rank != fromRank - '0'))
+                continue;
+            int promotion = abs(static_cast<int>(move.GetPromotion(white)));
+            if(promotion != promotionKind)
+                continue;
+            if(found.IsValid())
+                return Move{};
+            found = move;
+        }
+        return found;
+    }
+
+    /**
+     * @brief Piece letter, the least disambiguation that works, capture,
+     * target, promotion, then play the move on a copy to find the suffix.
+     */
+    size_t San::Write(const Position &position, Move move, char (&buffer)[MAX_SAN_LENGTH])
+    {
+        size_t length = 0;
+        bool white = position.IsWhiteToMove();
+        int from = move.GetFrom();
+        int to = move.GetTo();
+        ChessCoordinate fromCoordinate = ToChessCoordinate(from);
+        ChessCoordinate toCoordinate = ToChessCoordinate(to);
+        int pieceKind = PieceKindOn(position, from);
+
+        MoveList moves;
+        MoveGenerator::GenerateLegalMoves(position, moves);
+
+        if(move.GetFlag() == MoveFlag::Castling)
+        {
+            const char* castle = toCoordinate.file == 'g' ? "O-O" : "O-O-O";
+            while(*castle)
+                buffer[length++] = *castle++;
+        }
+        else
+        {
+            bool capture = position.GetPieceOnSquare(to) != PieceType::invalid || move.GetFlag() == MoveFlag::EnPassant;
+            if(pieceKind == 1)
+            {
+                if(capture)
+                    buffer[length++] = fromCoordinate.file;
+            }
+            else
+            {
+                buffer[length++] = " PBNRQK"[pieceKind];
+
+                bool ambiguous = false, sameFile = false, sameRank = false;
+                for(Move other : moves)
+                {
+                    if(other.GetTo() != to || other.GetFrom() == from || PieceKindOn(position, other.GetFrom()) != pieceKind)
+                        continue;
+                    ambiguous = true;
+                    ChessCoordinate otherFrom = ToChessCoordinate(other.GetFrom());
+                    sameFile |= otherFrom.file == fromCoordinate.file;
+                    sameRank |= otherFrom.rank == fromCoordinate.rank;
+                }
+                if(ambiguous && (!sameFile || sameRank))
+                    buffer[length++] = fromCoordinate.file;
+                if(ambiguous && sameFile)
+                    buffer[length++] = static_cast<char>('0' + fromCoordinate.rank);
+            }
+            if(capture)
+                buffer[length++] = 'x';
+            buffer[length++] = toCoordinate.file;
+            buffer[length++] = static_cast<char>('0' + toCoordinate.rank);
+            if(move.GetFlag() == MoveFlag::Promotion)
+            {
+                buffer[length++] = '=';
+                buffer[length++] = " PBNRQK"[abs(static_cast<int>(move.GetPromotion(white)))];
+            }
+        }
+
+        Position after = position;
+        UndoRecord undo;
+        after.MakeMove(move, undo);
+        if(after.IsInCheck(!white))
+        {
+            MoveList replies;
+            MoveGenerator::GenerateLegalMoves(after, replies);
+            buffer[length++] = replies.Empty() ? '#' : '+';
+        }
+        return length;
+    }
+
+    std::string San::ToString(const Position &position, Move move)
+    {
+        char buffer[MAX_SAN_LENGTH];
+        return std::string(buffer, Write(position, move, buffer));
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file Zobrist.cpp
+ * @brief Generation of the Zobrist keys.
+ */
+#include"framework/Zobrist.h"
+#include<mutex>
+
+namespace chess
+{
+    unique<Zobrist> Zobrist::mZobrist{nullptr};
+
+    namespace
+    {
+        std::once_flag sZobristOnce;    ///< Guards the lazy construction of `mZobrist`
+    }
+
+    /**
+     * @brief Get the singleton instance of `Zobrist`.
+     *
+     * Search and perft threads may be the first to hash a position, so the
+     * keys are generated exactly once across threads.
+     * @return Reference to the global `Zobrist`.
+     */
+    Zobrist& Zobrist::Get()
+    {
+        std::call_once(sZobristOnce, []()
+        {
+            mZobrist = std::move(unique<Zobrist>{new Zobrist});
+        });
+        return *mZobrist;
+    }
+
+    /**
+     * @brief Fill every key from a fixed seed.
+     *
+     * Castling keys are built from one key per right so that losing a right
+     * is the same XOR whatever the other rights are.
+     */
+    Zobrist::Zobrist()
+        :mPieceKeys{},
+        mCastlingKeys{},
+        mEnPassantKeys{},
+        mSideKey{0}
+    {
+        uint64_t state = UINT64_C(0x2545F4914F6CDD1D);
+
+        for(int piece = 0; piece < 12; piece++)
+        {
+            for(int square = 0; square < SQUARE_COUNT; square++)
+            {
+                mPieceKeys[piece][square] = NextRandom(state);
+            }
+        }
+
+        uint64_t rightKeys[4];
+        for(int i = 0; i < 4; i++)
+        {
+            rightKeys[i] = NextRandom(state);
+        }
+        for(int rights = 0; rights < 16; rights++)
+        {
+            for(int i = 0; i < 4; i++)
+            {
+                if(rights & (1 << i)) mCastlingKeys[rights] ^= rightKeys[i];
+            }
+        }
+
+        for(int file = 0; file < 8; file++)
+        {
+            mEnPassantKeys[file] = NextRandom(state);
+        }
+
+        mSideKey = NextRandom(state);
+    }
+
+    /**
+     * @brief SplitMix64 step; every output is a well mixed 64-bit key.
+     */
+    uint64_t Zobrist::NextRandom(uint64_t &state)
+    {
+        uint64_t z = (state += UINT64_C(0x9E3779B97F4A7C15));
+        z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+        return z ^ (z >> 31);
+    }
+}